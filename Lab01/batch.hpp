@@ -0,0 +1,71 @@
+#ifndef _batch_hpp_
+#define _batch_hpp_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <functional>
+#include <stdexcept>
+
+// --batch 模式：从标准输入逐行读取命令（格式与命令行参数相同），在同一进程内执行并流式输出结果
+// 曲线参数、上下文、系数缓存等在整个批次中只初始化一次，避免每个操作一次进程启动
+// 空行和 # 开头的行被忽略；命令失败时输出一行 "ERROR <原因>"，不会中断后续命令
+// 输入缓冲区读空时才刷新输出：管道批量输入时整块写出，交互式逐行驱动时每条命令后立即可见
+
+// 按空白切分，最多切出 max_fields 段，最后一段保留行内剩余的全部内容（用于含空格的消息）
+inline std::vector<std::string> split_fields(const std::string &line, size_t max_fields = (size_t)-1)
+{
+    std::vector<std::string> fields;
+    size_t i = 0;
+    while (i < line.size())
+    {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t'))
+            ++i;
+        if (i >= line.size())
+            break;
+        if (fields.size() + 1 == max_fields)
+        {
+            fields.push_back(line.substr(i));
+            break;
+        }
+        size_t j = i;
+        while (j < line.size() && line[j] != ' ' && line[j] != '\t')
+            ++j;
+        fields.push_back(line.substr(i, j - i));
+        i = j;
+    }
+    return fields;
+}
+
+// handler 处理一行命令，返回 false 表示参数错误；blank_line_after 为 true 时每条命令的输出后追加一个空行，
+// 供输出行数不固定的命令（如 shamir share）分隔结果
+inline int run_batch(const std::function<bool(const std::string &)> &handler, bool blank_line_after = false)
+{
+    std::ios::sync_with_stdio(false);
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line[0] == '#')
+            continue;
+        try
+        {
+            if (!handler(line))
+                std::cout << "ERROR 参数错误\n";
+        }
+        catch (const std::exception &e)
+        {
+            std::cout << "ERROR " << e.what() << "\n";
+        }
+        if (blank_line_after)
+            std::cout << "\n";
+        if (std::cin.rdbuf()->in_avail() <= 0)
+            std::cout.flush();
+    }
+    std::cout.flush();
+    return 0;
+}
+
+#endif // _batch_hpp_
@@ -0,0 +1,762 @@
+#ifndef _ec256_hpp_
+#define _ec256_hpp_
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "fp256.hpp"
+
+// 定长域上的短Weierstrass曲线 y^2 = x^3 + a*x + b，点运算全部在栈上的 Fp256 上完成
+// Jacobian 坐标 (X, Y, Z) 表示仿射点 (X/Z^2, Y/Z^3)，Z = 0 为无穷远点；加法与倍点都不求逆，
+// 只在输出（编码、比较）时归一化一次
+// 目前特化 P-256（a = -3，pedersen）与 secp256k1（a = 0，feldman / Schnorr）
+// 注意：查表下标与标量相关，不是常数时间实现，适用于承诺/验证的吞吐场景
+
+struct P256Curve
+{
+    typedef Fp256<P256P> F;
+    static constexpr int nid = NID_X9_62_prime256v1;
+    static constexpr bool a_minus3 = true; // a = -3
+    static constexpr const char *b = "5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B";
+    static constexpr const char *gx = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+    static constexpr const char *gy = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+};
+
+struct Secp256k1Curve
+{
+    typedef Fp256<Secp256k1P> F;
+    static constexpr int nid = NID_secp256k1;
+    static constexpr bool a_minus3 = false; // a = 0
+    static constexpr const char *b = "0000000000000000000000000000000000000000000000000000000000000007";
+    static constexpr const char *gx = "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798";
+    static constexpr const char *gy = "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8";
+};
+
+template <class C>
+struct EcAffine
+{
+    typename C::F x, y;
+    bool infinity = false;
+};
+
+template <class C>
+struct EcPoint
+{
+    typename C::F X, Y, Z; // 默认全0，即无穷远点
+
+    bool is_infinity() const { return Z.is_zero(); }
+    static EcPoint from_affine(const EcAffine<C> &a)
+    {
+        EcPoint p;
+        if (!a.infinity)
+        {
+            p.X = a.x;
+            p.Y = a.y;
+            p.Z = C::F::one();
+        }
+        return p;
+    }
+};
+
+// 标量：小端4个64位limb，调用者保证已约化到 [0, 群阶)
+struct EcScalar
+{
+    uint64_t l[4] = {0, 0, 0, 0};
+
+    static EcScalar from_bn(const BIGNUM *b)
+    {
+        unsigned char buf[32];
+        if (BN_is_negative(b) || BN_bn2lebinpad(b, buf, 32) < 0)
+            throw std::runtime_error("标量超出256位");
+        EcScalar s;
+        for (int i = 0; i < 4; ++i)
+            for (int k = 7; k >= 0; --k)
+                s.l[i] = (s.l[i] << 8) | buf[8 * i + k];
+        return s;
+    }
+
+    // 大端32字节（与 Fp256::to_bytes 的格式相同）
+    static EcScalar from_bytes(const unsigned char in[32])
+    {
+        EcScalar s;
+        for (int i = 0; i < 4; ++i)
+            for (int k = 0; k < 8; ++k)
+                s.l[i] = (s.l[i] << 8) | in[31 - 8 * i - 7 + k];
+        return s;
+    }
+
+    // 域元素（如模群阶的 Fp256）的普通值作为标量
+    template <class F>
+    static EcScalar from_field(const F &f)
+    {
+        unsigned char buf[32];
+        f.to_bytes(buf);
+        return from_bytes(buf);
+    }
+
+    unsigned byte(int j) const { return (unsigned)(l[j / 8] >> (8 * (j % 8))) & 0xFF; }
+
+    // 从第 bit 位开始的 c 位（c <= 16），超出256位的部分为0
+    unsigned window(int bit, int c) const
+    {
+        int limb = bit / 64, shift = bit % 64;
+        if (limb >= 4)
+            return 0;
+        uint64_t v = l[limb] >> shift;
+        if (shift + c > 64 && limb < 3)
+            v |= l[limb + 1] << (64 - shift);
+        return (unsigned)(v & ((1u << c) - 1));
+    }
+
+    // 有效位数，0 的位数为 0
+    int bits() const
+    {
+        for (int i = 3; i >= 0; --i)
+            if (l[i])
+                return 64 * i + 64 - __builtin_clzll(l[i]);
+        return 0;
+    }
+
+    // 宽度 w 的 NAF（2 <= w <= 8）：out[i] 为奇数或0，|out[i]| < 2^(w-1)，任意 w 个相邻位中至多一个非0
+    // 返回位数（不超过257），k = sum out[i] * 2^i
+    int wnaf(int w, int8_t out[257]) const
+    {
+        uint64_t k[5] = {l[0], l[1], l[2], l[3], 0}; // 加上负数位后可能进位到第257位
+        int len = 0;
+        while (k[0] | k[1] | k[2] | k[3] | k[4])
+        {
+            int d = 0;
+            if (k[0] & 1)
+            {
+                d = (int)(k[0] & ((1u << w) - 1));
+                if (d >= (1 << (w - 1)))
+                    d -= 1 << w;
+                // k -= d：d > 0 时低位清零不借位；d < 0 时加 |d|，向高位进位
+                if (d > 0)
+                    k[0] -= (uint64_t)d;
+                else
+                    for (int i = 0, carry = -d; i < 5 && carry; ++i)
+                    {
+                        k[i] += (uint64_t)carry;
+                        carry = k[i] < (uint64_t)carry;
+                    }
+            }
+            out[len++] = (int8_t)d;
+            for (int i = 0; i < 4; ++i)
+                k[i] = (k[i] >> 1) | (k[i + 1] << 63);
+            k[4] >>= 1;
+        }
+        return len;
+    }
+};
+
+namespace ec256_detail
+{
+    template <class F>
+    F from_hex(const char *hex)
+    {
+        BIGNUM *b = nullptr;
+        BN_hex2bn(&b, hex);
+        F f = F::from_bn(b);
+        BN_free(b);
+        return f;
+    }
+}
+
+// 曲线常数（Montgomery形式），首次使用时构造
+template <class C>
+struct EcCurveConsts
+{
+    typename C::F b;
+    EcAffine<C> g;
+    EcCurveConsts()
+    {
+        b = ec256_detail::from_hex<typename C::F>(C::b);
+        g.x = ec256_detail::from_hex<typename C::F>(C::gx);
+        g.y = ec256_detail::from_hex<typename C::F>(C::gy);
+    }
+};
+
+template <class C>
+const EcCurveConsts<C> &ec_consts()
+{
+    static const EcCurveConsts<C> consts;
+    return consts;
+}
+
+// 曲线方程右侧 x^3 + a*x + b
+template <class C>
+typename C::F ec_rhs(const typename C::F &x)
+{
+    typename C::F rhs = x * x * x + ec_consts<C>().b;
+    if (C::a_minus3)
+        rhs -= x + x + x;
+    return rhs;
+}
+
+template <class C>
+bool ec_on_curve(const typename C::F &x, const typename C::F &y)
+{
+    return y * y == ec_rhs<C>(x);
+}
+
+// 倍点：a = -3 用 dbl-2001-b（3M+5S），a = 0 用 dbl-2009-l（2M+5S）
+template <class C>
+EcPoint<C> ec_double(const EcPoint<C> &p)
+{
+    typedef typename C::F F;
+    if (p.is_infinity() || p.Y.is_zero())
+        return EcPoint<C>();
+    EcPoint<C> r;
+    if (C::a_minus3)
+    {
+        F delta = p.Z * p.Z, gamma = p.Y * p.Y, beta = p.X * gamma;
+        F t = (p.X - delta) * (p.X + delta);
+        F alpha = t + t + t;
+        F beta4 = beta + beta;
+        beta4 += beta4;
+        r.X = alpha * alpha - (beta4 + beta4);
+        F yz = p.Y + p.Z;
+        r.Z = yz * yz - gamma - delta;
+        F gamma2 = gamma * gamma;
+        F g8 = gamma2 + gamma2;
+        g8 += g8;
+        g8 += g8;
+        r.Y = alpha * (beta4 - r.X) - g8;
+    }
+    else
+    {
+        F A = p.X * p.X, B = p.Y * p.Y, Cc = B * B;
+        F xb = p.X + B;
+        F D = xb * xb - A - Cc;
+        D += D;
+        F E = A + A + A;
+        F Fv = E * E;
+        r.X = Fv - (D + D);
+        F c8 = Cc + Cc;
+        c8 += c8;
+        c8 += c8;
+        r.Y = E * (D - r.X) - c8;
+        F yz = p.Y * p.Z;
+        r.Z = yz + yz;
+    }
+    return r;
+}
+
+// Jacobian + 仿射点 (x, y)（madd-2007-bl，7M+4S），查表累加的主力；(x, y) 不能是无穷远点
+template <class C>
+EcPoint<C> ec_add_affine(const EcPoint<C> &p, const typename C::F &x, const typename C::F &y)
+{
+    typedef typename C::F F;
+    if (p.is_infinity())
+    {
+        EcPoint<C> r;
+        r.X = x;
+        r.Y = y;
+        r.Z = F::one();
+        return r;
+    }
+    F z1z1 = p.Z * p.Z;
+    F u2 = x * z1z1, s2 = y * p.Z * z1z1;
+    F h = u2 - p.X, rr = s2 - p.Y;
+    if (h.is_zero())
+        return rr.is_zero() ? ec_double(p) : EcPoint<C>();
+    F hh = h * h;
+    F i = hh + hh;
+    i += i;
+    F j = h * i;
+    rr += rr;
+    F v = p.X * i;
+    EcPoint<C> r;
+    r.X = rr * rr - j - (v + v);
+    F yj = p.Y * j;
+    r.Y = rr * (v - r.X) - (yj + yj);
+    F zh = p.Z + h;
+    r.Z = zh * zh - z1z1 - hh;
+    return r;
+}
+
+template <class C>
+EcPoint<C> ec_add_affine(const EcPoint<C> &p, const EcAffine<C> &q)
+{
+    return q.infinity ? p : ec_add_affine(p, q.x, q.y);
+}
+
+// Jacobian + Jacobian（add-2007-bl，11M+5S）
+template <class C>
+EcPoint<C> ec_add(const EcPoint<C> &p, const EcPoint<C> &q)
+{
+    typedef typename C::F F;
+    if (p.is_infinity())
+        return q;
+    if (q.is_infinity())
+        return p;
+    F z1z1 = p.Z * p.Z, z2z2 = q.Z * q.Z;
+    F u1 = p.X * z2z2, u2 = q.X * z1z1;
+    F s1 = p.Y * q.Z * z2z2, s2 = q.Y * p.Z * z1z1;
+    F h = u2 - u1, rr = s2 - s1;
+    if (h.is_zero())
+        return rr.is_zero() ? ec_double(p) : EcPoint<C>();
+    F h2 = h + h;
+    F i = h2 * h2;
+    F j = h * i;
+    rr += rr;
+    F v = u1 * i;
+    EcPoint<C> r;
+    r.X = rr * rr - j - (v + v);
+    F sj = s1 * j;
+    r.Y = rr * (v - r.X) - (sj + sj);
+    F zz = p.Z + q.Z;
+    r.Z = (zz * zz - z1z1 - z2z2) * h;
+    return r;
+}
+
+template <class C>
+EcPoint<C> ec_neg(const EcPoint<C> &p)
+{
+    EcPoint<C> r = p;
+    r.Y = typename C::F() - p.Y;
+    return r;
+}
+
+// 归一化到仿射坐标，一次域求逆
+template <class C>
+EcAffine<C> ec_to_affine(const EcPoint<C> &p)
+{
+    EcAffine<C> a;
+    if (p.is_infinity())
+    {
+        a.infinity = true;
+        return a;
+    }
+    typename C::F zi = p.Z.inv(), zi2 = zi * zi;
+    a.x = p.X * zi2;
+    a.y = p.Y * zi2 * zi;
+    return a;
+}
+
+// 两个 Jacobian 点是否相等：X1*Z2^2 == X2*Z1^2 且 Y1*Z2^3 == Y2*Z1^3，不求逆
+template <class C>
+bool ec_equal(const EcPoint<C> &p, const EcPoint<C> &q)
+{
+    if (p.is_infinity() || q.is_infinity())
+        return p.is_infinity() && q.is_infinity();
+    typename C::F pz2 = p.Z * p.Z, qz2 = q.Z * q.Z;
+    return p.X * qz2 == q.X * pz2 && p.Y * qz2 * q.Z == q.Y * pz2 * p.Z;
+}
+
+// Jacobian 点 p 是否等于仿射点 q：比较 X == x*Z^2、Y == y*Z^3，不求逆
+template <class C>
+bool ec_equal(const EcPoint<C> &p, const EcAffine<C> &q)
+{
+    if (p.is_infinity() || q.infinity)
+        return p.is_infinity() && q.infinity;
+    typename C::F z2 = p.Z * p.Z;
+    return p.X == q.x * z2 && p.Y == q.y * z2 * p.Z;
+}
+
+// SEC1 压缩编码：02/03 || x（大端32字节）；无穷远点编码为单字节 00
+template <class C>
+size_t ec_encode(const EcAffine<C> &a, unsigned char out[33])
+{
+    if (a.infinity)
+    {
+        out[0] = 0;
+        return 1;
+    }
+    out[0] = a.y.is_odd() ? 0x03 : 0x02;
+    a.x.to_bytes(out + 1);
+    return 33;
+}
+
+// 解码压缩（或未压缩）点并检查在曲线上，失败返回 false
+template <class C>
+bool ec_decode(const unsigned char *in, size_t len, EcAffine<C> &out)
+{
+    typedef typename C::F F;
+    if (len == 1 && in[0] == 0)
+    {
+        out = EcAffine<C>();
+        out.infinity = true;
+        return true;
+    }
+    F x, y;
+    if (len == 33 && (in[0] == 0x02 || in[0] == 0x03))
+    {
+        if (!F::from_bytes(in + 1, x))
+            return false;
+        if (!ec_rhs<C>(x).sqrt(y))
+            return false;
+        if (y.is_odd() != (in[0] == 0x03))
+            y = F() - y;
+    }
+    else if (len == 65 && in[0] == 0x04)
+    {
+        if (!F::from_bytes(in + 1, x) || !F::from_bytes(in + 33, y) || !ec_on_curve<C>(x, y))
+            return false;
+    }
+    else
+        return false;
+    out.x = x;
+    out.y = y;
+    out.infinity = false;
+    return true;
+}
+
+// 与 OpenSSL EC_POINT 互转（经过仿射坐标）
+template <class C>
+EcAffine<C> ec_from_openssl(const EC_GROUP *group, const EC_POINT *P, BN_CTX *ctx)
+{
+    EcAffine<C> a;
+    if (EC_POINT_is_at_infinity(group, P))
+    {
+        a.infinity = true;
+        return a;
+    }
+    BIGNUM *x = BN_new(), *y = BN_new();
+    EC_POINT_get_affine_coordinates(group, P, x, y, ctx);
+    a.x = C::F::from_bn(x);
+    a.y = C::F::from_bn(y);
+    BN_free(x);
+    BN_free(y);
+    return a;
+}
+
+template <class C>
+void ec_to_openssl(const EC_GROUP *group, const EcAffine<C> &a, EC_POINT *out, BN_CTX *ctx)
+{
+    if (a.infinity)
+    {
+        EC_POINT_set_to_infinity(group, out);
+        return;
+    }
+    BIGNUM *x = a.x.to_bn(), *y = a.y.to_bn();
+    EC_POINT_set_affine_coordinates(group, out, x, y, ctx);
+    BN_free(x);
+    BN_free(y);
+}
+
+// 批量归一化：前缀积 -> 一次求逆 -> 逆序回代，n 个点只需一次域求逆（Montgomery 技巧）
+template <class C>
+std::vector<EcAffine<C>> ec_batch_to_affine(const std::vector<EcPoint<C>> &pts)
+{
+    typedef typename C::F F;
+    size_t n = pts.size();
+    std::vector<EcAffine<C>> out(n);
+    std::vector<F> prefix(n);
+    F acc = F::one();
+    for (size_t i = 0; i < n; ++i)
+    {
+        prefix[i] = acc;
+        if (!pts[i].is_infinity())
+            acc *= pts[i].Z;
+    }
+    F inv = acc.inv();
+    for (size_t i = n; i-- > 0;)
+    {
+        if (pts[i].is_infinity())
+        {
+            out[i].infinity = true;
+            continue;
+        }
+        F zi = inv * prefix[i]; // 1 / Z_i
+        inv *= pts[i].Z;
+        F zi2 = zi * zi;
+        out[i].x = pts[i].X * zi2;
+        out[i].y = pts[i].Y * zi2 * zi;
+    }
+    return out;
+}
+
+// 批量压缩编码：n 个雅可比点共用一次求逆归一化（ec_batch_to_affine），再逐个按 ec_encode 编码
+// 第 i 个点写在 out + 33*i（out 至少 33*n 字节），返回每个点的编码长度（无穷远点为1）
+// 解压缩每点需要一次开方，无法像求逆那样共享，验证时应尽量重算点后编码比较，而不是解码输入
+template <class C>
+std::vector<size_t> ec_encode_batch(const std::vector<EcPoint<C>> &pts, unsigned char *out)
+{
+    std::vector<EcAffine<C>> aff = ec_batch_to_affine(pts);
+    std::vector<size_t> len(aff.size());
+    for (size_t i = 0; i < aff.size(); ++i)
+        len[i] = ec_encode(aff[i], out + 33 * i);
+    return len;
+}
+
+// 固定基点的梳状（comb）预计算表：标量按字节分成32列，
+// table[j][d-1] = d * 2^(8j) * P（d = 1..255，仿射坐标）
+// k*P = sum_j table[j][byte_j(k)]：32次混合加法，没有倍点；每张表 32*255 个点，每点恰好占一条64字节缓存行，约 510KiB
+// 建表约 8000 次点加，所有点一次批量归一化，可保存到文件下次直接加载
+template <class C>
+class EcFixedBase
+{
+public:
+    static const int COLUMNS = 32;
+    static const int DIGITS = 255;
+
+    explicit EcFixedBase(const EcAffine<C> &base) : base(base)
+    {
+        if (base.infinity)
+            throw std::runtime_error("基点不能是无穷远点");
+        std::vector<EcPoint<C>> jac((size_t)COLUMNS * DIGITS);
+        EcPoint<C> col = EcPoint<C>::from_affine(base); // 2^(8j) * P
+        for (int j = 0; j < COLUMNS; ++j)
+        {
+            EcPoint<C> *row = &jac[(size_t)j * DIGITS];
+            row[0] = col;
+            for (int d = 1; d < DIGITS; ++d)
+                row[d] = ec_add(row[d - 1], col);
+            col = ec_double(row[127]); // 256 * 2^(8j) * P
+        }
+        std::vector<EcAffine<C>> aff = ec_batch_to_affine(jac);
+        table.resize(aff.size());
+        for (size_t i = 0; i < aff.size(); ++i)
+        {
+            table[i].x = aff[i].x;
+            table[i].y = aff[i].y;
+        }
+    }
+
+    // 乘以标量并累加到 acc 上（默认从无穷远点开始），结果为 Jacobian 坐标
+    // 多个固定基点的线性组合（如 m*G + r*H）共用一个累加器，省掉最后的 Jacobian 加法
+    EcPoint<C> mul(const EcScalar &k, EcPoint<C> acc = EcPoint<C>()) const
+    {
+        const Entry *col[COLUMNS];
+        int used = 0;
+        for (int j = 0; j < COLUMNS; ++j) // 表项地址开始时就全部已知，先统一预取，让缓存缺失重叠
+        {
+            unsigned d = k.byte(j);
+            if (d)
+            {
+                col[used] = &table[(size_t)j * DIGITS + d - 1];
+                __builtin_prefetch(col[used++]);
+            }
+        }
+        for (int j = 0; j < used; ++j)
+            acc = ec_add_affine<C>(acc, col[j]->x, col[j]->y);
+        return acc;
+    }
+
+    const EcAffine<C> &base_point() const { return base; }
+
+    // 表文件：魔数 "ECFB" | 曲线nid(4字节) | 基点压缩编码(33字节) | 表中各点的 x、y（Montgomery形式原始limb）
+    // 文件只用于同一台机器上的缓存，不做跨平台字节序转换
+    void save(const std::string &path) const
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        unsigned char head[41];
+        file_header(head);
+        out.write((const char *)head, sizeof(head));
+        out.write((const char *)table.data(), table.size() * sizeof(Entry));
+        if (!out.flush())
+            throw std::runtime_error("写入预计算表失败: " + path);
+    }
+
+    // 从文件加载，基点或曲线不符、文件不完整或表项抽查不符时返回 nullptr
+    static EcFixedBase *load(const std::string &path, const EcAffine<C> &base)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return nullptr;
+        EcFixedBase *fb = new EcFixedBase(base, 0);
+        unsigned char head[41], expect[41];
+        fb->file_header(expect);
+        fb->table.resize((size_t)COLUMNS * DIGITS);
+        bool ok = in.read((char *)head, sizeof(head)) && std::memcmp(head, expect, sizeof(head)) == 0 &&
+                  in.read((char *)fb->table.data(), fb->table.size() * sizeof(Entry));
+        // table[0][0] 必须是基点本身，其余各点至少要在曲线上（约 8000 次曲线方程检查，远快于重新建表）
+        ok = ok && fb->table[0].x == base.x && fb->table[0].y == base.y;
+        for (size_t i = 1; ok && i < fb->table.size(); ++i)
+            ok = ec_on_curve<C>(fb->table[i].x, fb->table[i].y);
+        // 曲线上的点不一定是正确的表项：由基点重新倍点得到各列的 2^(8j)*P，
+        // 检查每列最后一项满足 255*c + c == 256*c（256 次倍点 + 32 次加法），过期或被改动的表在这里被拒绝
+        EcPoint<C> col = EcPoint<C>::from_affine(base);
+        for (int j = 0; ok && j < COLUMNS; ++j)
+        {
+            EcPoint<C> next = col;
+            for (int k = 0; k < 8; ++k)
+                next = ec_double(next);
+            const Entry &last = fb->table[(size_t)j * DIGITS + DIGITS - 1];
+            ok = ec_equal(ec_add_affine<C>(col, last.x, last.y), next);
+            col = next;
+        }
+        if (!ok)
+        {
+            delete fb;
+            return nullptr;
+        }
+        return fb;
+    }
+
+private:
+    struct alignas(64) Entry
+    {
+        typename C::F x, y;
+    };
+    static_assert(sizeof(Entry) == 64, "表项应恰好占一条缓存行");
+
+    EcFixedBase(const EcAffine<C> &base, int) : base(base) {}
+
+    void file_header(unsigned char head[41]) const
+    {
+        std::memcpy(head, "ECFB", 4);
+        uint32_t nid = (uint32_t)C::nid;
+        for (int i = 0; i < 4; ++i)
+            head[4 + i] = (unsigned char)(nid >> (8 * i));
+        ec_encode(base, head + 8);
+    }
+
+    EcAffine<C> base;
+    std::vector<Entry> table;
+};
+
+// Straus（Shamir 技巧）双标量乘法 a*P + b*Q：两个标量的 wNAF 交错处理，共用一条倍点链
+// 约 256 次倍点 + 2*256/(w+1) 次混合加法，而两次独立的标量乘法需要 512 次倍点；没有中间点
+// P、Q 的奇数倍 1,3,..,2^(w-1)-1 倍各 2^(w-2) 个，16个点一次批量归一化后用混合加法
+template <class C>
+EcPoint<C> ec_mul2(const EcScalar &a, const EcAffine<C> &P, const EcScalar &b, const EcAffine<C> &Q)
+{
+    const int W = 5, HALF = 1 << (W - 2);
+    std::vector<EcPoint<C>> odd(2 * HALF);
+    const EcAffine<C> *base[2] = {&P, &Q};
+    for (int t = 0; t < 2; ++t)
+    {
+        if (base[t]->infinity)
+            continue; // 全部为无穷远点，归一化后查表时跳过
+        EcPoint<C> p1 = EcPoint<C>::from_affine(*base[t]), p2 = ec_double(p1);
+        odd[t * HALF] = p1;
+        for (int i = 1; i < HALF; ++i)
+            odd[t * HALF + i] = ec_add(odd[t * HALF + i - 1], p2);
+    }
+    std::vector<EcAffine<C>> table = ec_batch_to_affine(odd);
+
+    int8_t naf[2][257];
+    int len[2] = {a.wnaf(W, naf[0]), b.wnaf(W, naf[1])};
+    EcPoint<C> acc;
+    for (int i = std::max(len[0], len[1]) - 1; i >= 0; --i)
+    {
+        acc = ec_double(acc);
+        for (int t = 0; t < 2; ++t)
+        {
+            int d = i < len[t] ? naf[t][i] : 0;
+            if (d == 0)
+                continue;
+            const EcAffine<C> &e = table[t * HALF + (std::abs(d) >> 1)];
+            if (e.infinity)
+                continue;
+            acc = ec_add_affine<C>(acc, e.x, d > 0 ? e.y : typename C::F() - e.y);
+        }
+    }
+    return acc;
+}
+
+// Pippenger 分桶多标量乘法 sum k_i * P_i：标量按 c 位一窗改写为有符号数字 d ∈ [-2^(c-1), 2^(c-1)]
+// （d > 2^(c-1) 时减去 2^c 并向下一窗进位），负数字把点取负（仿射取负只需 p - y）后放进 |d| 号桶，
+// 桶数因此减半为 2^(c-1)。每个窗口每点一次混合加法，再用后缀和 sum j*B_j 求出窗口的和（约 2^c 次加法），
+// 窗口之间 c 次倍点。总代价约 (bits/c + 1) * (n + 2^c)，c 按点数和标量位数取最小值，每点的摊销代价随 n 增大而下降
+// 标量较短（如批量验证的128位随机权重）时窗口数按实际位数减少
+template <class C>
+EcPoint<C> ec_msm(const std::vector<EcScalar> &k, const std::vector<EcAffine<C>> &P)
+{
+    size_t n = std::min(k.size(), P.size());
+    int bits = 0;
+    for (size_t i = 0; i < n; ++i)
+        bits = std::max(bits, k[i].bits());
+    if (bits == 0)
+        return EcPoint<C>();
+    int c = 1;
+    double best = 0;
+    for (int t = 1; t <= 16; ++t)
+    {
+        double cost = (double)(bits / t + 1) * ((double)n + (double)(1u << t));
+        if (t == 1 || cost < best)
+        {
+            best = cost;
+            c = t;
+        }
+    }
+
+    // 最高窗口只含不足 c 位的剩余位加上进位，不会超过 2^(c-1)，因此 bits/c + 1 个窗口足够
+    const int windows = bits / c + 1, half = 1 << (c - 1);
+    std::vector<int32_t> digits(n * windows);
+    for (size_t i = 0; i < n; ++i)
+    {
+        int carry = 0;
+        for (int w = 0; w < windows; ++w)
+        {
+            int d = (int)k[i].window(w * c, c) + carry;
+            carry = d > half;
+            digits[i * windows + w] = carry ? d - (1 << c) : d;
+        }
+    }
+
+    std::vector<EcPoint<C>> buckets(half + 1);
+    EcPoint<C> acc;
+    for (int w = windows - 1; w >= 0; --w)
+    {
+        for (int i = 0; i < c; ++i)
+            acc = ec_double(acc);
+        std::fill(buckets.begin(), buckets.end(), EcPoint<C>());
+        for (size_t i = 0; i < n; ++i)
+        {
+            int d = digits[i * windows + w];
+            if (d == 0 || P[i].infinity)
+                continue;
+            if (d > 0)
+                buckets[d] = ec_add_affine<C>(buckets[d], P[i].x, P[i].y);
+            else
+                buckets[-d] = ec_add_affine<C>(buckets[-d], P[i].x, typename C::F() - P[i].y);
+        }
+        EcPoint<C> running, sum; // running = sum_{i>=j} B_i，sum = sum_j running_j = sum_j j*B_j
+        for (size_t j = buckets.size() - 1; j > 0; --j)
+        {
+            running = ec_add(running, buckets[j]);
+            sum = ec_add(sum, running);
+        }
+        acc = ec_add(acc, sum);
+    }
+    return acc;
+}
+
+// OpenSSL 接口的 R = a*P + b*Q，失败时返回 false
+// secp256k1 走上面的定长 Straus 实现（OpenSSL 对它只有通用实现，实测快4倍以上）；
+// 其它曲线（如 P-256，OpenSSL 有汇编实现，比这里的可移植C++快）交给 OpenSSL：
+// 其中一个点是生成元时用 EC_POINT_mul 的“生成元 + 任意点”单次调用，否则两次标量乘法再相加
+inline bool ec_mul2(const EC_GROUP *group, EC_POINT *R, const BIGNUM *a, const EC_POINT *P, const BIGNUM *b,
+                    const EC_POINT *Q, BN_CTX *ctx)
+{
+    if (EC_GROUP_get_curve_name(group) == Secp256k1Curve::nid)
+    {
+        const BIGNUM *order = EC_GROUP_get0_order(group);
+        BIGNUM *ar = BN_new(), *br = BN_new();
+        bool ok = BN_nnmod(ar, a, order, ctx) && BN_nnmod(br, b, order, ctx);
+        if (ok)
+        {
+            EcPoint<Secp256k1Curve> r = ec_mul2(EcScalar::from_bn(ar), ec_from_openssl<Secp256k1Curve>(group, P, ctx),
+                                                EcScalar::from_bn(br), ec_from_openssl<Secp256k1Curve>(group, Q, ctx));
+            ec_to_openssl(group, ec_to_affine(r), R, ctx);
+        }
+        BN_free(ar);
+        BN_free(br);
+        return ok;
+    }
+    const EC_POINT *gen = EC_GROUP_get0_generator(group);
+    if (gen && EC_POINT_cmp(group, P, gen, ctx) == 0)
+        return EC_POINT_mul(group, R, a, Q, b, ctx) == 1;
+    if (gen && EC_POINT_cmp(group, Q, gen, ctx) == 0)
+        return EC_POINT_mul(group, R, b, P, a, ctx) == 1;
+    EC_POINT *bQ = EC_POINT_new(group);
+    bool ok = bQ && EC_POINT_mul(group, R, nullptr, P, a, ctx) && EC_POINT_mul(group, bQ, nullptr, Q, b, ctx) &&
+              EC_POINT_add(group, R, R, bQ, ctx);
+    EC_POINT_free(bQ);
+    return ok;
+}
+
+#endif // _ec256_hpp_
@@ -0,0 +1,628 @@
+#ifndef _fp256_hpp_
+#define _fp256_hpp_
+
+#include <openssl/bn.h>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+// 定长256位素域元素：4个64位limb（小端），Montgomery形式，全部在栈上
+// 模数在编译期给定（constexpr），-m^{-1} mod 2^64 与 R^2 mod m 也在编译期算好
+// 用于替代热循环中堆分配的 BIGNUM，目前特化了 secp256k1 与 P-256 的素数 p 与群阶 n
+
+typedef unsigned __int128 u128;
+
+namespace fp256_detail
+{
+    struct U256
+    {
+        uint64_t l[4];
+    };
+
+    constexpr int hex_digit(char c)
+    {
+        return (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : c - 'A' + 10;
+    }
+
+    // 64个十六进制字符（大端）-> 小端limb
+    constexpr U256 parse_hex(const char *hex)
+    {
+        U256 r{{0, 0, 0, 0}};
+        for (int i = 0; i < 64; ++i)
+        {
+            int limb = (63 - i) / 16;
+            r.l[limb] = (r.l[limb] << 4) | (uint64_t)hex_digit(hex[i]);
+        }
+        return r;
+    }
+
+    constexpr bool geq(const U256 &a, const U256 &b)
+    {
+        for (int i = 3; i >= 0; --i)
+            if (a.l[i] != b.l[i])
+                return a.l[i] > b.l[i];
+        return true;
+    }
+
+    // a - b mod 2^256，返回借位
+    constexpr uint64_t sub(U256 &r, const U256 &a, const U256 &b)
+    {
+        uint64_t borrow = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            uint64_t d = a.l[i] - b.l[i];
+            uint64_t b1 = a.l[i] < b.l[i];
+            r.l[i] = d - borrow;
+            borrow = b1 | (d < borrow);
+        }
+        return borrow;
+    }
+
+    // a + b mod 2^256，返回进位
+    constexpr uint64_t add(U256 &r, const U256 &a, const U256 &b)
+    {
+        uint64_t carry = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            uint64_t s = a.l[i] + b.l[i];
+            uint64_t c1 = s < a.l[i];
+            r.l[i] = s + carry;
+            carry = c1 | (r.l[i] < s);
+        }
+        return carry;
+    }
+
+    // -m0^{-1} mod 2^64，牛顿迭代（m0为奇数）
+    constexpr uint64_t neg_inv64(uint64_t m0)
+    {
+        uint64_t inv = 1;
+        for (int i = 0; i < 6; ++i)
+            inv *= 2 - m0 * inv;
+        return 0 - inv;
+    }
+
+    // 2^512 mod m：从1开始做512次模倍加
+    constexpr U256 r2_mod(const U256 &m)
+    {
+        U256 x{{1, 0, 0, 0}};
+        for (int i = 0; i < 512; ++i)
+        {
+            U256 d{{0, 0, 0, 0}};
+            uint64_t carry = add(d, x, x);
+            if (carry || geq(d, m))
+                sub(d, d, m);
+            x = d;
+        }
+        return x;
+    }
+}
+
+// secp256k1 基域素数 p（shamir.cpp 的 P_HEX）
+struct Secp256k1P
+{
+    static constexpr fp256_detail::U256 m = fp256_detail::parse_hex("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+    static constexpr uint64_t n0 = fp256_detail::neg_inv64(m.l[0]);
+    static constexpr fp256_detail::U256 r2 = fp256_detail::r2_mod(m);
+};
+
+// secp256k1 群阶 n（feldman.cpp 的份额域）
+struct Secp256k1N
+{
+    static constexpr fp256_detail::U256 m = fp256_detail::parse_hex("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+    static constexpr uint64_t n0 = fp256_detail::neg_inv64(m.l[0]);
+    static constexpr fp256_detail::U256 r2 = fp256_detail::r2_mod(m);
+};
+
+// NIST P-256（prime256v1）基域素数 p（pedersen.cpp 的曲线）
+struct P256P
+{
+    static constexpr fp256_detail::U256 m = fp256_detail::parse_hex("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    static constexpr uint64_t n0 = fp256_detail::neg_inv64(m.l[0]);
+    static constexpr fp256_detail::U256 r2 = fp256_detail::r2_mod(m);
+};
+
+// NIST P-256 群阶 n（pedersen 批量验证中对标量做线性组合）
+struct P256N
+{
+    static constexpr fp256_detail::U256 m = fp256_detail::parse_hex("FFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551");
+    static constexpr uint64_t n0 = fp256_detail::neg_inv64(m.l[0]);
+    static constexpr fp256_detail::U256 r2 = fp256_detail::r2_mod(m);
+};
+
+template <class P>
+class Fp256
+{
+    static_assert(P::m.l[3] >> 63, "Fp256 要求模数最高位为1（m > 2^255）");
+
+public:
+    fp256_detail::U256 v{{0, 0, 0, 0}}; // a*R mod m
+
+    static Fp256 zero() { return Fp256(); }
+    static Fp256 one() { return from_word(1); }
+
+    static Fp256 from_word(uint64_t w)
+    {
+        Fp256 a;
+        a.v.l[0] = w;
+        mont_mul(a.v, a.v, P::r2); // w * R^2 * R^{-1} = w*R
+        return a;
+    }
+
+    // 要求 b 非负；超过256位时先取模
+    static Fp256 from_bn(const BIGNUM *b)
+    {
+        unsigned char buf[32];
+        if (BN_num_bits(b) > 256)
+        {
+            BIGNUM *mod = to_bn_raw(P::m);
+            BIGNUM *r = BN_new();
+            BN_CTX *ctx = BN_CTX_new();
+            BN_nnmod(r, b, mod, ctx);
+            BN_bn2lebinpad(r, buf, 32);
+            BN_CTX_free(ctx);
+            BN_free(r);
+            BN_free(mod);
+        }
+        else
+            BN_bn2lebinpad(b, buf, 32);
+        Fp256 a;
+        for (int i = 0; i < 4; ++i)
+        {
+            uint64_t w = 0;
+            for (int k = 7; k >= 0; --k)
+                w = (w << 8) | buf[8 * i + k];
+            a.v.l[i] = w;
+        }
+        if (fp256_detail::geq(a.v, P::m)) // m > 2^255，一次减法即可
+            fp256_detail::sub(a.v, a.v, P::m);
+        mont_mul(a.v, a.v, P::r2);
+        return a;
+    }
+
+    // 写入已有的 BIGNUM，不分配
+    void to_bn(BIGNUM *out) const
+    {
+        fp256_detail::U256 plain;
+        fp256_detail::U256 one{{1, 0, 0, 0}};
+        mont_mul(plain, v, one); // 退出Montgomery形式
+        unsigned char buf[32];
+        for (int i = 0; i < 4; ++i)
+            for (int k = 0; k < 8; ++k)
+                buf[8 * i + k] = (unsigned char)(plain.l[i] >> (8 * k));
+        BN_lebin2bn(buf, 32, out);
+    }
+
+    // 大端32字节，不经过 BIGNUM（点压缩编码用）
+    void to_bytes(unsigned char out[32]) const
+    {
+        fp256_detail::U256 plain;
+        fp256_detail::U256 one{{1, 0, 0, 0}};
+        mont_mul(plain, v, one);
+        for (int i = 0; i < 4; ++i)
+            for (int k = 0; k < 8; ++k)
+                out[31 - 8 * i - k] = (unsigned char)(plain.l[i] >> (8 * k));
+    }
+
+    // 大端32字节；值不小于模数时返回 false（编码不规范）
+    static bool from_bytes(const unsigned char in[32], Fp256 &out)
+    {
+        Fp256 a;
+        for (int i = 0; i < 4; ++i)
+        {
+            uint64_t w = 0;
+            for (int k = 0; k < 8; ++k)
+                w = (w << 8) | in[31 - 8 * i - (7 - k)];
+            a.v.l[i] = w;
+        }
+        if (fp256_detail::geq(a.v, P::m))
+            return false;
+        mont_mul(a.v, a.v, P::r2);
+        out = a;
+        return true;
+    }
+
+    BIGNUM *to_bn() const
+    {
+        BIGNUM *out = BN_new();
+        to_bn(out);
+        return out;
+    }
+
+    // mod 是否就是该域的模数
+    static bool matches(const BIGNUM *mod)
+    {
+        if (BN_is_negative(mod) || BN_num_bits(mod) != 256)
+            return false;
+        unsigned char buf[32];
+        BN_bn2lebinpad(mod, buf, 32);
+        for (int i = 0; i < 4; ++i)
+            for (int k = 0; k < 8; ++k)
+                if (buf[8 * i + k] != (unsigned char)(P::m.l[i] >> (8 * k)))
+                    return false;
+        return true;
+    }
+
+    bool is_zero() const { return (v.l[0] | v.l[1] | v.l[2] | v.l[3]) == 0; }
+    bool operator==(const Fp256 &o) const
+    {
+        return v.l[0] == o.v.l[0] && v.l[1] == o.v.l[1] && v.l[2] == o.v.l[2] && v.l[3] == o.v.l[3];
+    }
+    bool operator!=(const Fp256 &o) const { return !(*this == o); }
+
+    friend Fp256 operator+(const Fp256 &a, const Fp256 &b)
+    {
+        Fp256 r;
+        uint64_t carry = fp256_detail::add(r.v, a.v, b.v);
+        if (carry || fp256_detail::geq(r.v, P::m))
+            fp256_detail::sub(r.v, r.v, P::m);
+        return r;
+    }
+
+    friend Fp256 operator-(const Fp256 &a, const Fp256 &b)
+    {
+        Fp256 r;
+        if (fp256_detail::sub(r.v, a.v, b.v))
+            fp256_detail::add(r.v, r.v, P::m);
+        return r;
+    }
+
+    friend Fp256 operator*(const Fp256 &a, const Fp256 &b)
+    {
+        Fp256 r;
+        mont_mul(r.v, a.v, b.v);
+        return r;
+    }
+
+    Fp256 &operator+=(const Fp256 &o) { return *this = *this + o; }
+    Fp256 &operator-=(const Fp256 &o) { return *this = *this - o; }
+    Fp256 &operator*=(const Fp256 &o) { return *this = *this * o; }
+
+    // 乘以普通（非Montgomery形式）的64位整数：(aR)*w = (aw)R，结果仍是Montgomery形式
+    // 5-limb 乘积用 2^256 ≡ c = 2^256 - m 折叠高位，对 secp256k1 的 p/n（c < 2^130）只需一两轮
+    Fp256 mul_word(uint64_t w) const
+    {
+        fp256_detail::U256 lo;
+        uint64_t hi = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            u128 s = (u128)v.l[i] * w + hi;
+            lo.l[i] = (uint64_t)s;
+            hi = (uint64_t)(s >> 64);
+        }
+        while (hi)
+        {
+            uint64_t h = hi;
+            hi = 0;
+            for (int i = 0; i < 4; ++i) // lo += h * c
+            {
+                u128 s = (u128)C.l[i] * h + lo.l[i] + hi;
+                lo.l[i] = (uint64_t)s;
+                hi = (uint64_t)(s >> 64);
+            }
+        }
+        Fp256 r;
+        r.v = lo;
+        if (fp256_detail::geq(r.v, P::m))
+            fp256_detail::sub(r.v, r.v, P::m);
+        return r;
+    }
+
+    // 4位固定窗口求 a^e，e 为普通（非Montgomery形式）的256位整数
+    // 约 256 次平方 + 64 次乘法；P-256 的 p-2 几乎全是1，比逐位平方-乘少约三分之一
+    Fp256 pow(const fp256_detail::U256 &e) const
+    {
+        Fp256 table[16];
+        table[0] = one();
+        for (int i = 1; i < 16; ++i)
+            table[i] = table[i - 1] * *this;
+        Fp256 r = one();
+        for (int i = 63; i >= 0; --i)
+        {
+            for (int k = 0; k < 4 && i != 63; ++k)
+                r = r * r;
+            unsigned d = (unsigned)(e.l[i / 16] >> (4 * (i % 16))) & 0xF;
+            if (d)
+                r = r * table[d];
+        }
+        return r;
+    }
+
+    // 二进制扩展欧几里得求逆：只有移位与加减，比费马小定理 a^(m-2)（约320次乘法）快数倍
+    // 把 Montgomery 表示 aR 当作普通整数求逆得到 a^{-1}R^{-1}，再乘两次 R^2 换回 a^{-1}R
+    // 循环次数与输入有关，不是常数时间
+    Fp256 inv() const
+    {
+        using namespace fp256_detail;
+        if (is_zero())
+            throw std::runtime_error("没有逆元");
+        U256 u = v, w = P::m, x1{{1, 0, 0, 0}}, x2{{0, 0, 0, 0}};
+        auto is_one = [](const U256 &a) { return a.l[0] == 1 && (a.l[1] | a.l[2] | a.l[3]) == 0; };
+        auto shr1 = [](U256 &a, uint64_t top) {
+            for (int i = 0; i < 3; ++i)
+                a.l[i] = (a.l[i] >> 1) | (a.l[i + 1] << 63);
+            a.l[3] = (a.l[3] >> 1) | (top << 63);
+        };
+        auto half = [&](U256 &x) { // x/2 mod m
+            uint64_t carry = (x.l[0] & 1) ? add(x, x, P::m) : 0;
+            shr1(x, carry);
+        };
+        // 不变式：x1*(aR) ≡ u，x2*(aR) ≡ w (mod m)
+        while (!is_one(u) && !is_one(w))
+        {
+            while (!(u.l[0] & 1))
+            {
+                shr1(u, 0);
+                half(x1);
+            }
+            while (!(w.l[0] & 1))
+            {
+                shr1(w, 0);
+                half(x2);
+            }
+            if (geq(u, w))
+            {
+                sub(u, u, w);
+                if (sub(x1, x1, x2))
+                    add(x1, x1, P::m);
+            }
+            else
+            {
+                sub(w, w, u);
+                if (sub(x2, x2, x1))
+                    add(x2, x2, P::m);
+            }
+        }
+        Fp256 r;
+        r.v = is_one(u) ? x1 : x2;
+        mont_mul(r.v, r.v, P::r2); // a^{-1}
+        mont_mul(r.v, r.v, P::r2); // a^{-1}R
+        return r;
+    }
+
+    // 平方根，要求 m ≡ 3 (mod 4)（secp256k1 的 p 与 P-256 的 p 均满足）：a^((m+1)/4)
+    // 不是二次剩余时返回 false
+    bool sqrt(Fp256 &out) const
+    {
+        static_assert((P::m.l[0] & 3) == 3, "sqrt 要求 m ≡ 3 (mod 4)");
+        fp256_detail::U256 e = P::m;
+        for (int i = 0; i < 4; ++i) // (m+1)/4 = (m >> 2) + 1，m 低两位为 11
+            e.l[i] = (e.l[i] >> 2) | (i < 3 ? e.l[i + 1] << 62 : 0);
+        fp256_detail::U256 one_{{1, 0, 0, 0}};
+        fp256_detail::add(e, e, one_);
+        Fp256 r = pow(e);
+        if (r * r != *this)
+            return false;
+        out = r;
+        return true;
+    }
+
+    // 普通形式的最低位（压缩点的 y 奇偶）
+    bool is_odd() const
+    {
+        fp256_detail::U256 plain;
+        fp256_detail::U256 one_{{1, 0, 0, 0}};
+        mont_mul(plain, v, one_);
+        return plain.l[0] & 1;
+    }
+
+private:
+    static constexpr fp256_detail::U256 neg_mod()
+    {
+        fp256_detail::U256 c{{0, 0, 0, 0}};
+        fp256_detail::sub(c, c, P::m);
+        return c;
+    }
+    static constexpr fp256_detail::U256 C = neg_mod(); // 2^256 - m
+
+    static BIGNUM *to_bn_raw(const fp256_detail::U256 &x)
+    {
+        unsigned char buf[32];
+        for (int i = 0; i < 4; ++i)
+            for (int k = 0; k < 8; ++k)
+                buf[8 * i + k] = (unsigned char)(x.l[i] >> (8 * k));
+        return BN_lebin2bn(buf, 32, nullptr);
+    }
+
+    // CIOS Montgomery乘法：r = a*b*R^{-1} mod m，r 可与 a/b 重叠
+    static void mont_mul(fp256_detail::U256 &r, const fp256_detail::U256 &a, const fp256_detail::U256 &b)
+    {
+        uint64_t t[6] = {0, 0, 0, 0, 0, 0};
+        for (int i = 0; i < 4; ++i)
+        {
+            uint64_t carry = 0;
+            for (int j = 0; j < 4; ++j)
+            {
+                u128 s = (u128)a.l[j] * b.l[i] + t[j] + carry;
+                t[j] = (uint64_t)s;
+                carry = (uint64_t)(s >> 64);
+            }
+            u128 s = (u128)t[4] + carry;
+            t[4] = (uint64_t)s;
+            t[5] = (uint64_t)(s >> 64);
+
+            uint64_t q = t[0] * P::n0;
+            s = (u128)q * P::m.l[0] + t[0];
+            carry = (uint64_t)(s >> 64);
+            for (int j = 1; j < 4; ++j)
+            {
+                s = (u128)q * P::m.l[j] + t[j] + carry;
+                t[j - 1] = (uint64_t)s;
+                carry = (uint64_t)(s >> 64);
+            }
+            s = (u128)t[4] + carry;
+            t[3] = (uint64_t)s;
+            t[4] = t[5] + (uint64_t)(s >> 64);
+        }
+        fp256_detail::U256 res{{t[0], t[1], t[2], t[3]}};
+        if (t[4] || fp256_detail::geq(res, P::m))
+            fp256_detail::sub(res, res, P::m);
+        r = res;
+    }
+};
+
+// 霍纳法则求 f(x)，coeffs 升次
+template <class F>
+F fp_eval_poly(const std::vector<F> &coeffs, const F &x)
+{
+    F res;
+    for (size_t i = coeffs.size(); i-- > 0;)
+        res = res * x + coeffs[i];
+    return res;
+}
+
+// 在连续整数点 x = x0, x0+1, ..., x0+n-1 上求值（前向有限差分）：先用霍纳法则求出 f(x0..x0+d)，
+// 原地构造各阶差分 v_k = Δ^k f(x0)，之后每前进一个点只需 d = t-1 次域加法
+// 结果写入 out[0..n)；多线程时每个线程从自己区间的起点各自建表
+template <class F>
+void fp_eval_consecutive(const std::vector<F> &coeffs, uint64_t x0, size_t n, F *out)
+{
+    size_t d = coeffs.empty() ? 0 : coeffs.size() - 1; // 多项式次数
+    std::vector<F> v(d + 1);
+    F x = F::from_word(x0), one = F::one();
+    for (size_t k = 0; k <= d; ++k, x += one)
+        v[k] = fp_eval_poly(coeffs, x);
+    for (size_t level = 1; level <= d; ++level)
+        for (size_t k = d; k >= level; --k)
+            v[k] -= v[k - 1];
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = v[0];
+        for (size_t k = 0; k < d; ++k) // 升序：v_k 使用尚未更新的 v_{k+1}
+            v[k] += v[k + 1];
+    }
+}
+
+// 拉格朗日基函数 l_i(0) = X / e_i，其中 X = prod x_j，e_i = x_i * prod_{j!=i}(x_j - x_i)
+// 计算分为两步：各 e_i 互相独立（O(t) 次乘法，可按 i 分给多个线程），
+// 再由 fp_lagrange_finish 串行做一次批量求逆（只有一次域求逆）
+
+// e_i，xs 为域元素
+template <class F>
+F fp_lagrange_denominator(const std::vector<F> &xs, size_t i)
+{
+    F e = xs[i];
+    for (size_t j = 0; j < xs.size(); ++j)
+        if (j != i)
+            e *= xs[j] - xs[i];
+    return e;
+}
+
+// e_i，x 均为小整数（份额序号）：差值先在64位字内连乘，攒满一个字才做一次 mul_word
+template <class F>
+F fp_lagrange_denominator_small(const std::vector<uint64_t> &xs, size_t i)
+{
+    F e = F::from_word(xs[i]);
+    uint64_t word = 1;
+    bool negative = false;
+    for (size_t j = 0; j < xs.size(); ++j)
+    {
+        if (j == i)
+            continue;
+        uint64_t d = xs[j] > xs[i] ? xs[j] - xs[i] : xs[i] - xs[j];
+        if (d == 0)
+            throw std::runtime_error("没有逆元"); // 重复的x
+        negative ^= xs[j] < xs[i];
+        if (word > UINT64_MAX / d)
+        {
+            e = e.mul_word(word);
+            word = d;
+        }
+        else
+            word *= d;
+    }
+    e = e.mul_word(word);
+    return negative ? F() - e : e;
+}
+
+// 输入 e[i] = e_i，输出 e[i] = X / e_i；scratch 存前缀积，由调用者提供以便复用
+template <class F>
+void fp_lagrange_finish(std::vector<F> &e, const F &X, std::vector<F> &scratch)
+{
+    size_t t = e.size();
+    scratch.resize(t);
+    if (t == 0)
+        return;
+    for (size_t i = 0; i < t; ++i)
+        scratch[i] = i ? scratch[i - 1] * e[i] : e[i];
+    F inv = scratch[t - 1].inv(); // 存在重复或为0的x时抛出异常
+    for (size_t i = t; i-- > 0;)
+    {
+        F e_inv = i ? inv * scratch[i - 1] : inv;
+        inv *= e[i];
+        e[i] = X * e_inv;
+    }
+}
+
+// 单线程批量求逆计算全部 l_i(0)
+template <class F>
+void fp_basis_at_zero(const std::vector<F> &xs, std::vector<F> &out, std::vector<F> &scratch)
+{
+    out.resize(xs.size());
+    F X = F::one();
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        out[i] = fp_lagrange_denominator(xs, i);
+        X *= xs[i];
+    }
+    fp_lagrange_finish(out, X, scratch);
+}
+
+// 任意点插值（重心形式）：w_i = 1 / prod_{j!=i}(x_i - x_j)，
+// f(z) = l(z) * sum(w_i * y_i / (z - x_i))，l(z) = prod(z - x_j)
+// 权重只依赖节点，求一次后对每个目标点只需 O(t) 次乘法与一次求逆
+
+// prod_{j!=i}(x_i - x_j)，对全部 i 求出后用 fp_lagrange_finish(d, F::one(), scratch) 批量取逆即得 w_i
+template <class F>
+F fp_barycentric_denominator(const std::vector<F> &xs, size_t i)
+{
+    F d = F::one();
+    for (size_t j = 0; j < xs.size(); ++j)
+        if (j != i)
+            d *= xs[i] - xs[j];
+    return d;
+}
+
+// 由 wy[i] = w_i * y_i 求 f(z)；z 恰为某个节点时直接返回 ys[i]
+template <class F>
+F fp_interpolate_at(const std::vector<F> &xs, const std::vector<F> &ys, const std::vector<F> &wy, const F &z,
+                    std::vector<F> &scratch)
+{
+    size_t t = xs.size();
+    scratch.resize(t);
+    if (t == 0)
+        return F();
+    for (size_t i = 0; i < t; ++i)
+    {
+        F d = z - xs[i];
+        if (d.is_zero())
+            return ys[i];
+        scratch[i] = i ? scratch[i - 1] * d : d;
+    }
+    F l = scratch[t - 1], inv = l.inv(), sum;
+    for (size_t i = t; i-- > 0;) // 逆序回代得到每个 1/(z - x_i)
+    {
+        F d_inv = i ? inv * scratch[i - 1] : inv;
+        inv *= z - xs[i];
+        sum += wy[i] * d_inv;
+    }
+    return l * sum;
+}
+
+// 若 mod 是编译期特化的模数之一，用对应的域类型调用 fn(F{}) 并返回 true；否则返回 false 走通用 BIGNUM 路径
+template <class Fn>
+bool with_fixed_field(const BIGNUM *mod, Fn &&fn)
+{
+    if (Fp256<Secp256k1P>::matches(mod))
+    {
+        fn(Fp256<Secp256k1P>());
+        return true;
+    }
+    if (Fp256<Secp256k1N>::matches(mod))
+    {
+        fn(Fp256<Secp256k1N>());
+        return true;
+    }
+    return false;
+}
+
+#endif // _fp256_hpp_
@@ -0,0 +1,142 @@
+#ifndef _fp_poly_hpp_
+#define _fp_poly_hpp_
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+#include "fp256.hpp"
+
+// 定长素域上的多项式运算，系数升次存放，末尾不留0系数（零多项式为空向量）
+// 供纠错重构（Gao 译码）使用，规模为份额数 n，全部 O(n^2) 的教科书算法
+
+template <class F>
+void poly_trim(std::vector<F> &a)
+{
+    while (!a.empty() && a.back().is_zero())
+        a.pop_back();
+}
+
+// 次数，零多项式为 -1
+template <class F>
+long poly_deg(const std::vector<F> &a)
+{
+    return (long)a.size() - 1;
+}
+
+template <class F>
+std::vector<F> poly_mul(const std::vector<F> &a, const std::vector<F> &b)
+{
+    if (a.empty() || b.empty())
+        return {};
+    std::vector<F> r(a.size() + b.size() - 1);
+    for (size_t i = 0; i < a.size(); ++i)
+        for (size_t j = 0; j < b.size(); ++j)
+            r[i + j] += a[i] * b[j];
+    poly_trim(r);
+    return r;
+}
+
+template <class F>
+std::vector<F> poly_sub(const std::vector<F> &a, const std::vector<F> &b)
+{
+    std::vector<F> r(std::max(a.size(), b.size()));
+    for (size_t i = 0; i < a.size(); ++i)
+        r[i] = a[i];
+    for (size_t i = 0; i < b.size(); ++i)
+        r[i] -= b[i];
+    poly_trim(r);
+    return r;
+}
+
+// a = q*b + r，deg r < deg b；首项系数只求一次逆
+template <class F>
+void poly_divmod(const std::vector<F> &a, const std::vector<F> &b, std::vector<F> &q, std::vector<F> &r)
+{
+    if (b.empty())
+        throw std::runtime_error("多项式除数为0");
+    r = a;
+    q.assign(a.size() >= b.size() ? a.size() - b.size() + 1 : 0, F());
+    F lead_inv = b.back().inv();
+    for (size_t i = q.size(); i-- > 0;)
+    {
+        F c = r[i + b.size() - 1] * lead_inv;
+        q[i] = c;
+        if (c.is_zero())
+            continue;
+        for (size_t j = 0; j < b.size(); ++j)
+            r[i + j] -= c * b[j];
+    }
+    poly_trim(q);
+    poly_trim(r);
+}
+
+// Gao 译码（Reed–Solomon）：点 (xs[i], ys[i]) 中至多 e 个错误，且 n >= k + 2e 时，
+// 一次求出次数 < k 的唯一多项式 f
+//   1. g0 = prod(x - x_i)，g1 为经过全部点的插值多项式（次数 < n）
+//   2. 对 (g0, g1) 做扩展欧几里得，余式次数首次 < (n+k)/2 时停止，得到 g 与系数 v
+//   3. f = g / v，整除且 deg f < k 即成功，v 的根正是出错的点
+// 成功时写入 f 与出错点的下标 bad，错误过多无法唯一译码时返回 false
+template <class F>
+bool fp_gao_decode(const std::vector<F> &xs, const std::vector<F> &ys, size_t k, std::vector<F> &f,
+                   std::vector<size_t> &bad)
+{
+    size_t n = xs.size();
+    if (k == 0 || n < k)
+        return false;
+
+    // g0 = prod(x - x_i)
+    std::vector<F> g0{F::one()};
+    for (size_t i = 0; i < n; ++i)
+    {
+        g0.push_back(F());
+        for (size_t j = g0.size() - 1; j > 0; --j)
+            g0[j] = g0[j - 1] - xs[i] * g0[j];
+        g0[0] = F() - xs[i] * g0[0];
+    }
+
+    // g1 = sum(y_i * w_i * g0 / (x - x_i))，w_i 为重心权重，g0 / (x - x_i) 用综合除法
+    std::vector<F> w(n), scratch, g1(n), quo(n);
+    for (size_t i = 0; i < n; ++i)
+        w[i] = fp_barycentric_denominator(xs, i);
+    fp_lagrange_finish(w, F::one(), scratch); // x 重复时抛出异常
+    for (size_t i = 0; i < n; ++i)
+    {
+        F c = w[i] * ys[i];
+        if (c.is_zero())
+            continue;
+        F carry = g0[n];
+        for (size_t j = n; j-- > 0;)
+        {
+            quo[j] = carry;
+            carry = g0[j] + xs[i] * carry;
+        }
+        for (size_t j = 0; j < n; ++j)
+            g1[j] += c * quo[j];
+    }
+    poly_trim(g1);
+
+    // 部分扩展欧几里得，只跟踪 g1 的系数 v
+    std::vector<F> r0 = g0, r1 = g1, v0, v1{F::one()}, q, r;
+    while (2 * poly_deg(r1) >= (long)(n + k))
+    {
+        poly_divmod(r0, r1, q, r);
+        std::vector<F> v2 = poly_sub(v0, poly_mul(q, v1));
+        r0.swap(r1);
+        r1.swap(r);
+        v0.swap(v1);
+        v1.swap(v2);
+    }
+
+    poly_divmod(r1, v1, f, r);
+    if (!r.empty() || poly_deg(f) >= (long)k)
+        return false;
+
+    bad.clear();
+    for (size_t i = 0; i < n; ++i)
+        if (fp_eval_poly(f, xs[i]) != ys[i])
+            bad.push_back(i);
+    return 2 * bad.size() <= n - k;
+}
+
+#endif // _fp_poly_hpp_
@@ -0,0 +1,185 @@
+#ifndef _gf256_hpp_
+#define _gf256_hpp_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GF256_X86 1
+#endif
+
+// GF(2^8) 有限域运算，约化多项式 x^8 + x^4 + x^3 + x + 1（0x11B，与AES相同）
+// 按字节的Shamir分享中每个字节独立成为一个秘密，加法即异或
+// 批量核心运算 dst ^= c * src：
+//   AVX2 / SSSE3：把 c*src 拆成高低半字节两次 pshufb 查表（每个常数各16字节的表）
+//   标量回退：整张 256x256 乘法表逐字节查表
+// 运行时检测CPU，选择最快的实现
+
+struct GF256Tables
+{
+    uint8_t exp[512];
+    uint8_t log[256];
+    uint8_t mul[256][256];
+    alignas(16) uint8_t lo[256][16]; // lo[c][i] = c * i
+    alignas(16) uint8_t hi[256][16]; // hi[c][i] = c * (i << 4)
+
+    GF256Tables()
+    {
+        uint8_t x = 1;
+        for (int i = 0; i < 255; ++i)
+        {
+            exp[i] = exp[i + 255] = x;
+            log[x] = (uint8_t)i;
+            // x *= 3（生成元）
+            uint8_t x2 = (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1B : 0));
+            x ^= x2;
+        }
+        exp[510] = exp[0];
+        exp[511] = exp[1];
+        log[0] = 0;
+        for (int a = 0; a < 256; ++a)
+            for (int b = 0; b < 256; ++b)
+                mul[a][b] = (a && b) ? exp[log[a] + log[b]] : 0;
+        for (int c = 0; c < 256; ++c)
+            for (int i = 0; i < 16; ++i)
+            {
+                lo[c][i] = mul[c][i];
+                hi[c][i] = mul[c][i << 4];
+            }
+    }
+};
+
+inline const GF256Tables &gf256_tables()
+{
+    static const GF256Tables tables;
+    return tables;
+}
+
+inline uint8_t gf256_mul(uint8_t a, uint8_t b)
+{
+    return gf256_tables().mul[a][b];
+}
+
+inline uint8_t gf256_inv(uint8_t a)
+{
+    if (a == 0)
+        throw std::runtime_error("没有逆元");
+    const GF256Tables &T = gf256_tables();
+    return T.exp[255 - T.log[a]];
+}
+
+// dst[i] ^= c * src[i]
+typedef void (*gf256_mul_add_fn)(uint8_t *dst, const uint8_t *src, uint8_t c, size_t len);
+
+inline void gf256_mul_add_scalar(uint8_t *dst, const uint8_t *src, uint8_t c, size_t len)
+{
+    const uint8_t *row = gf256_tables().mul[c];
+    for (size_t i = 0; i < len; ++i)
+        dst[i] ^= row[src[i]];
+}
+
+#ifdef GF256_X86
+__attribute__((target("ssse3"))) inline void gf256_mul_add_ssse3(uint8_t *dst, const uint8_t *src, uint8_t c, size_t len)
+{
+    const GF256Tables &T = gf256_tables();
+    const __m128i lo = _mm_load_si128((const __m128i *)T.lo[c]);
+    const __m128i hi = _mm_load_si128((const __m128i *)T.hi[c]);
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(s, mask));
+        __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(s, 4), mask));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(d, _mm_xor_si128(l, h)));
+    }
+    gf256_mul_add_scalar(dst + i, src + i, c, len - i);
+}
+
+__attribute__((target("avx2"))) inline void gf256_mul_add_avx2(uint8_t *dst, const uint8_t *src, uint8_t c, size_t len)
+{
+    const GF256Tables &T = gf256_tables();
+    const __m256i lo = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)T.lo[c]));
+    const __m256i hi = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)T.hi[c]));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) // 每轮两个向量，隐藏 pshufb 延迟
+    {
+        __m256i s0 = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i s1 = _mm256_loadu_si256((const __m256i *)(src + i + 32));
+        __m256i p0 = _mm256_xor_si256(_mm256_shuffle_epi8(lo, _mm256_and_si256(s0, mask)),
+                                      _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi64(s0, 4), mask)));
+        __m256i p1 = _mm256_xor_si256(_mm256_shuffle_epi8(lo, _mm256_and_si256(s1, mask)),
+                                      _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi64(s1, 4), mask)));
+        __m256i d0 = _mm256_loadu_si256((const __m256i *)(dst + i));
+        __m256i d1 = _mm256_loadu_si256((const __m256i *)(dst + i + 32));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_xor_si256(d0, p0));
+        _mm256_storeu_si256((__m256i *)(dst + i + 32), _mm256_xor_si256(d1, p1));
+    }
+    gf256_mul_add_ssse3(dst + i, src + i, c, len - i);
+}
+#endif
+
+struct GF256Kernel
+{
+    const char *name;
+    gf256_mul_add_fn mul_add;
+};
+
+// 运行时选择：AVX2 > SSSE3 > 标量
+inline const GF256Kernel &gf256_kernel()
+{
+    static const GF256Kernel kernel = []
+    {
+#ifdef GF256_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return GF256Kernel{"avx2", gf256_mul_add_avx2};
+        if (__builtin_cpu_supports("ssse3"))
+            return GF256Kernel{"ssse3", gf256_mul_add_ssse3};
+#endif
+        return GF256Kernel{"scalar", gf256_mul_add_scalar};
+    }();
+    return kernel;
+}
+
+inline void gf256_mul_add(uint8_t *dst, const uint8_t *src, uint8_t c, size_t len)
+{
+    if (c == 0)
+        return;
+    if (c == 1)
+    {
+        for (size_t i = 0; i < len; ++i)
+            dst[i] ^= src[i];
+        return;
+    }
+    gf256_kernel().mul_add(dst, src, c, len);
+}
+
+// GF(2^8) 上的拉格朗日基函数在0处的值：l_i(0) = prod_{j!=i} x_j / (x_j ^ x_i)
+inline std::vector<uint8_t> gf256_basis_at_zero(const std::vector<uint8_t> &xs)
+{
+    std::vector<uint8_t> l(xs.size());
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        uint8_t num = 1, den = 1;
+        for (size_t j = 0; j < xs.size(); ++j)
+        {
+            if (j == i)
+                continue;
+            if (xs[j] == xs[i])
+                throw std::runtime_error("份额序号重复");
+            num = gf256_mul(num, xs[j]);
+            den = gf256_mul(den, xs[j] ^ xs[i]);
+        }
+        l[i] = gf256_mul(num, gf256_inv(den));
+    }
+    return l;
+}
+
+#endif // _gf256_hpp_
@@ -1,144 +1,349 @@
-#include <openssl/rand.h>
-#include <openssl/sha.h>
-#include <iostream>
-#include <iomanip>
-#include <sstream>
-#include <string>
-#include <vector>
-
-// TODO: 学生需要实现此函数 - 将字节转换为十六进制字符串（作为工具函数）
-std::string to_hex(const std::vector<unsigned char> &buf)
+#include "hash_commit.hpp"
+
+using namespace hc;
+
+// 批量命令使用的 SHA-256 实现，--sha-impl 选项可指定（默认按 CPU 自动选择）
+static Sha256Impl g_sha_impl = Sha256Impl::Auto;
+
+// TODO: 学生需要实现此函数 - 创建承诺并输出结果
+/// @brief 哈西承诺
+/// @param message ASCII明文字符串
+/// @return 输出十六进制Commit和Nonce
+void do_commit(const std::string &message)
 {
-    // 提示：可使用std::ostringstream和std::hex, std::setw, std::setfill
-    // 实现将字节向量转换为十六进制字符串
-    // 例如：{0x1, 0x2, 0xAB} 应该转换为 "0102ab"
+    // 提示：
+    // 1. 生成随机数
+    // 2. 计算承诺值
+    // 3. 打印出承诺值和随机数的十六进制表示，用空格分隔(调用to_hex函数)
     // 你的代码在这里
-    using namespace std; 
-    {
-        ostringstream oss;
-        for (unsigned char byte : buf) {
-            oss << hex << setw(2) << setfill('0') << (int)byte;
-        }
-        return oss.str();
-    }
+    auto rand_nonce = generate_nonce();
+    auto hex_nonce = to_hex(rand_nonce);
+    auto hash_commit = commit(message, rand_nonce);
+    std::cout << to_hex(hash_commit) << " " << hex_nonce << "\n";
 }
 
-// TODO: 学生需要实现此函数 - 将十六进制字符串转换为字节（作为工具函数）
-std::vector<unsigned char> hex_to_bytes(const std::string &hex)
+// 逐行读取文件，跳过空行和 # 开头的行，每攒够 chunk 行调用一次 process(行号, 行内容)，最后处理剩余的行
+template <class Process>
+void for_each_chunk(const std::string &path, size_t chunk, Process process)
 {
-    // 提示：hex字符串每两个字符代表一个字节
-    // 例如："0102ab" 应该转换为 {0x1, 0x2, 0xAB}
-    // 你的代码在这里
-    using namespace std; 
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("无法打开文件: " + path);
+    std::vector<size_t> linenos;
+    std::vector<std::string> lines;
+    std::string line;
+    for (size_t lineno = 1; std::getline(in, line); ++lineno)
     {
-        vector<unsigned char> bytes;
-        for (size_t i = 0; i < hex.length(); i += 2) {
-            string byteString = hex.substr(i, 2);
-            unsigned char byte = (unsigned char) strtol(byteString.c_str(), nullptr, 16);
-            bytes.push_back(byte);
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line[0] == '#')
+            continue;
+        linenos.push_back(lineno);
+        lines.push_back(line);
+        if (lines.size() == chunk)
+        {
+            process(linenos, lines);
+            linenos.clear();
+            lines.clear();
         }
-        return bytes;
     }
+    if (!lines.empty())
+        process(linenos, lines);
 }
 
-// TODO: 学生需要实现此函数 - 对数据进行SHA256哈希
-std::vector<unsigned char> sha256(const std::vector<unsigned char> &data)
+// commit-batch：文件每行一条消息，输出与 commit 相同的 "<commit_hex> <nonce_hex>" 行
+void do_commit_batch(const std::string &path)
 {
-    // 提示：使用OpenSSL的SHA256函数
-    // SHA256_DIGEST_LENGTH是哈希输出的长度
-    // 你的代码在这里
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256(data.data(),data.size(),hash);
-    std::vector<unsigned char> result;
-    result.insert(result.end(),hash,hash+SHA256_DIGEST_LENGTH);
-    return result;
-    // return {}; // 临时返回，学生需要替换
+    const size_t CHUNK = 1 << 16;
+    for_each_chunk(path, CHUNK, [](const std::vector<size_t> &, const std::vector<std::string> &messages)
+                   {
+        std::vector<unsigned char> rnd(32 * messages.size());
+        if (RAND_bytes(rnd.data(), (int)rnd.size()) != 1)
+            throw std::runtime_error("RAND_bytes failed");
+        std::vector<std::vector<unsigned char>> nonces(messages.size());
+        for (size_t i = 0; i < messages.size(); ++i)
+            nonces[i].assign(rnd.begin() + 32 * i, rnd.begin() + 32 * (i + 1));
+        std::vector<std::vector<unsigned char>> commits = commit_batch(messages, nonces, g_sha_impl);
+        std::string text;
+        for (size_t i = 0; i < messages.size(); ++i)
+            text += hex_encode(commits[i].data(), 32, true) + " " + hex_encode(nonces[i].data(), 32, true) + "\n";
+        std::cout << text; });
 }
 
-// TODO: 学生需要实现此函数 - 生成指定长度的安全随机数
-/// @brief 产生随机数
-/// @param len int_32 随机数长度
-/// @return rand_bytes int_32 随机数
-std::vector<unsigned char> generate_nonce(size_t len = 32)
+// verify-batch：文件每行 "<commit_hex> <nonce_hex> <message>"，返回无效行的行号，total 为参与验证的行数
+std::vector<size_t> do_verify_batch(const std::string &path, size_t &total)
 {
-    // 提示：使用OpenSSL的RAND_bytes函数生成随机数
-    // 你的代码在这里
-    std::vector<unsigned char> rand_bytes(len); 
-    RAND_bytes(rand_bytes.data(), len);
-    return rand_bytes;
+    const size_t CHUNK = 1 << 16;
+    std::vector<size_t> bad;
+    total = 0;
+    for_each_chunk(path, CHUNK, [&](const std::vector<size_t> &linenos, const std::vector<std::string> &lines)
+                   {
+        std::vector<std::vector<unsigned char>> commits, nonces;
+        std::vector<std::string> messages;
+        std::vector<size_t> at;
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            std::vector<std::string> f = split_fields(lines[i], 3);
+            std::vector<unsigned char> c, n;
+            if (f.size() != 3 || !hex_decode(f[0], c) || c.size() != 32 || !hex_decode(f[1], n))
+            {
+                bad.push_back(linenos[i]); // 格式错误直接记为无效
+                continue;
+            }
+            commits.push_back(std::move(c));
+            nonces.push_back(std::move(n));
+            messages.push_back(f[2]);
+            at.push_back(linenos[i]);
+        }
+        std::vector<bool> valid = verify_batch(commits, messages, nonces, g_sha_impl);
+        for (size_t i = 0; i < valid.size(); ++i)
+            if (!valid[i])
+                bad.push_back(at[i]);
+        total += lines.size(); });
+    std::sort(bad.begin(), bad.end());
+    return bad;
 }
 
-// TODO: 学生需要实现此函数 - 计算承诺值，即SHA256(message || nonce)
-/// @brief 
-/// @param message ASCII明文字符串
-/// @param nonce bytes随机数
-/// @return 
-std::vector<unsigned char> commit(const std::string &message, const std::vector<unsigned char> &nonce)
+// 对文件计算承诺并输出 "<commit_hex> <nonce_hex>"，吞吐量输出到标准错误，不影响标准输出的解析
+void do_commit_file(const std::string &path)
 {
-    // 提示：将消息和随机数连接起来，然后计算SHA256哈希
-    // message需要先转换为字节向量
-    // 你的代码在这里
-    auto vec_message = std::vector<unsigned char>(message.begin(), message.end());
-    vec_message.insert(vec_message.end(), nonce.begin(), nonce.end());
-    auto res = sha256(vec_message);
-    return res;
+    std::vector<unsigned char> nonce = generate_nonce();
+    uint64_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<unsigned char> c = commit_file(path, nonce, bytes);
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << to_hex(c) << " " << to_hex(nonce) << "\n";
+    std::cerr << std::fixed << std::setprecision(3) << bytes / 1e9 << " GB, " << sec << " s, " << bytes / 1e9 / sec << " GB/s\n";
 }
 
-// TODO: 学生需要实现此函数 - 创建承诺并输出结果
-/// @brief 哈西承诺
-/// @param message ASCII明文字符串
-/// @return 输出十六进制Commit和Nonce
-void do_commit(const std::string &message)
+bool verify_file(const std::string &commit_hex, const std::string &nonce_hex, const std::string &path)
 {
-    // 提示：
-    // 1. 生成随机数
-    // 2. 计算承诺值
-    // 3. 打印出承诺值和随机数的十六进制表示，用空格分隔(调用to_hex函数)
-    // 你的代码在这里
-    auto rand_nonce = generate_nonce();
-    auto hex_nonce = to_hex(rand_nonce);
-    auto hash_commit = commit(message, rand_nonce);
-    std::cout << to_hex(hash_commit) << " " << hex_nonce << std::endl;
+    std::vector<unsigned char> c, nonce;
+    if (!hex_decode(commit_hex, c) || c.size() != SHA256_DIGEST_LENGTH || !hex_decode(nonce_hex, nonce))
+        return false;
+    uint64_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    bool ok = commit_file(path, nonce, bytes) == c;
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << std::fixed << std::setprecision(3) << bytes / 1e9 << " GB, " << sec << " s, " << bytes / 1e9 / sec << " GB/s\n";
+    return ok;
 }
 
-// TODO: 学生需要实现此函数 - 验证承诺是否正确
-bool verify(const std::string &commit_hex, const std::string &nonce_hex, const std::string &message)
+// 承诺者保存的打开信息，每行 "<nonce_hex> <message>"（消息为第一个空格之后的全部内容）
+static bool parse_opening(const std::string &line, std::vector<unsigned char> &nonce, std::string &message)
 {
-    // 提示：将十六进制字符串转换为字节向量(hex_to_bytes函数) ，重新计算承诺值，并比较
-    // 你的代码在这里
-    auto hex_message = std::vector<unsigned char>(message.begin(), message.end());
-    auto hex_commit = commit(message, hex_to_bytes(nonce_hex));
-    if (to_hex(hex_commit) == commit_hex) {
-        return true;
-    } else {
+    if (line.size() < 65 || line[64] != ' ' || !hex_decode(line.substr(0, 64), nonce))
         return false;
+    message = line.substr(65);
+    return true;
+}
+
+// merkle-commit：文件每行一条消息，叶子为 commit(m_i, r_i)，只公开 "<root_hex> <n>"
+// 打开信息写入 out_path 由承诺者保存；叶子下标从 0 开始，按文件中的消息顺序（空行与 # 行不计）
+void do_merkle_commit(const std::string &path, const std::string &out_path)
+{
+    std::ofstream out(out_path);
+    if (!out)
+        throw std::runtime_error("无法写入文件: " + out_path);
+    std::vector<unsigned char> level;
+    for_each_chunk(path, 1 << 16, [&](const std::vector<size_t> &, const std::vector<std::string> &messages)
+                   {
+        std::vector<unsigned char> rnd(32 * messages.size());
+        if (RAND_bytes(rnd.data(), (int)rnd.size()) != 1)
+            throw std::runtime_error("RAND_bytes failed");
+        std::vector<Sha256Msg> msgs(messages.size());
+        std::string text;
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            msgs[i] = {(const unsigned char *)messages[i].data(), messages[i].size(), rnd.data() + 32 * i, 32};
+            text += hex_encode(rnd.data() + 32 * i, 32, true) + " " + messages[i] + "\n";
+        }
+        size_t at = level.size();
+        level.resize(at + 32 * messages.size());
+        sha256_batch(msgs.data(), msgs.size(), (unsigned char (*)[32])(level.data() + at), g_sha_impl);
+        out << text; });
+    size_t n = level.size() / 32;
+    std::vector<std::vector<unsigned char>> paths;
+    merkle_build(level, {}, paths, g_sha_impl);
+    std::cout << hex_encode(level.data(), 32, true) << " " << n << "\n";
+}
+
+// merkle-open：由打开信息重建叶子与树，为每个下标输出 "<index> <nonce_hex> <path_hex> <message>"
+// 认证路径为自底向上的兄弟节点拼接（n = 1 时为空，输出 "-"）
+void do_merkle_open(const std::string &path, const std::vector<size_t> &indices)
+{
+    std::vector<std::string> nonce_hex(indices.size()), message(indices.size());
+    std::vector<unsigned char> level;
+    for_each_chunk(path, 1 << 16, [&](const std::vector<size_t> &linenos, const std::vector<std::string> &lines)
+                   {
+        size_t base = level.size() / 32;
+        std::vector<std::vector<unsigned char>> nonces(lines.size());
+        std::vector<std::string> messages(lines.size());
+        std::vector<Sha256Msg> msgs(lines.size());
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            if (!parse_opening(lines[i], nonces[i], messages[i]) || nonces[i].size() != 32)
+                throw std::runtime_error("第 " + std::to_string(linenos[i]) + " 行: 打开信息格式错误");
+            msgs[i] = {(const unsigned char *)messages[i].data(), messages[i].size(), nonces[i].data(), 32};
+        }
+        level.resize(level.size() + 32 * lines.size());
+        sha256_batch(msgs.data(), msgs.size(), (unsigned char (*)[32])(level.data() + 32 * base), g_sha_impl);
+        for (size_t k = 0; k < indices.size(); ++k)
+            if (indices[k] >= base && indices[k] < base + lines.size())
+            {
+                nonce_hex[k] = hex_encode(nonces[indices[k] - base].data(), 32, true);
+                message[k] = messages[indices[k] - base];
+            } });
+    std::vector<std::vector<unsigned char>> paths;
+    merkle_build(level, indices, paths, g_sha_impl);
+    for (size_t k = 0; k < indices.size(); ++k)
+    {
+        std::string path_hex = paths[k].empty() ? "-" : hex_encode(paths[k].data(), paths[k].size(), true);
+        std::cout << indices[k] << " " << nonce_hex[k] << " " << path_hex << " " << message[k] << "\n";
     }
 }
 
+// 各 SHA-256 实现的批量承诺吞吐（消息 len 字节 + 32 字节随机数），与逐条调用 commit（OpenSSL 一次性 SHA256）对比
+void bench_sha(size_t count = 1 << 20)
+{
+    std::cout << std::setw(10) << "impl" << std::setw(8) << "len" << std::setw(14) << "Mmsg/s" << std::setw(10) << "MB/s" << "\n";
+    std::vector<unsigned char> nonce = generate_nonce();
+    for (size_t len : {16, 100, 1000})
+    {
+        std::string message(len, 'm');
+        size_t n = count / (1 + len / 64);
+        auto report = [&](const char *name, double sec)
+        {
+            std::cout << std::setw(10) << name << std::setw(8) << len << std::fixed << std::setprecision(2) << std::setw(14)
+                      << n / sec / 1e6 << std::setw(10) << std::setprecision(0) << n * (len + 32) / sec / 1e6 << "\n";
+        };
+
+        std::vector<Sha256Msg> msgs(n, {(const unsigned char *)message.data(), len, nonce.data(), nonce.size()});
+        std::vector<unsigned char> out(32 * n);
+        for (int i = 0; i < (int)Sha256Impl::Auto; ++i)
+        {
+            Sha256Impl impl = (Sha256Impl)i;
+            if (!sha256_impl_supported(impl))
+                continue;
+            auto start = std::chrono::steady_clock::now();
+            sha256_batch(msgs.data(), n, (unsigned char (*)[32])out.data(), impl);
+            report(sha256_impl_name(impl), std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < n; ++i)
+            commit(message, nonce);
+        report("openssl", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::cout << "自动选择: " << sha256_impl_name(sha256_best_impl()) << "\n";
+}
+
+// 执行一条命令，args[0] 为命令名；参数错误时返回 false
+bool run_command(const std::vector<std::string> &args)
+{
+    if (args.size() >= 2 && args[0] == "commit")
+        do_commit(args[1]);
+    else if (args.size() == 4 && args[0] == "open-verify")
+        std::cout << (verify(args[1], args[2], args[3]) ? "OK" : "FAIL") << "\n";
+    else if (args.size() == 2 && args[0] == "commit-file")
+        do_commit_file(args[1]);
+    else if (args.size() == 4 && args[0] == "open-verify-file")
+        std::cout << (verify_file(args[1], args[2], args[3]) ? "OK" : "FAIL") << "\n";
+    else if (args.size() == 2 && args[0] == "commit-batch")
+        do_commit_batch(args[1]);
+    else if (args.size() == 2 && args[0] == "verify-batch")
+    { // 第一行 OK/FAIL 与计数，有无效项时第二行列出其行号
+        size_t total = 0;
+        std::vector<size_t> bad = do_verify_batch(args[1], total);
+        if (bad.empty())
+            std::cout << "OK " << total << "\n";
+        else
+        {
+            std::cout << "FAIL " << bad.size() << "/" << total << "\n无效的行:";
+            for (size_t l : bad)
+                std::cout << " " << l;
+            std::cout << "\n";
+        }
+    }
+    else if (args.size() == 3 && args[0] == "merkle-commit")
+        do_merkle_commit(args[1], args[2]);
+    else if (args.size() >= 3 && args[0] == "merkle-open")
+    {
+        std::vector<size_t> indices;
+        for (size_t i = 2; i < args.size(); ++i)
+        {
+            size_t pos = 0;
+            indices.push_back(std::stoull(args[i], &pos));
+            if (pos != args[i].size())
+                throw std::invalid_argument("无效的下标: " + args[i]);
+        }
+        do_merkle_open(args[1], indices);
+    }
+    else if (args.size() == 7 && args[0] == "merkle-verify")
+        std::cout << (merkle_open_verify(args[1], args[2], args[3], args[4], args[5], args[6]) ? "OK" : "FAIL") << "\n";
+    else if (args.size() == 1 && args[0] == "bench-sha")
+        bench_sha();
+    else
+        return false;
+    return true;
+}
+
 int main(int argc, char **argv)
 {
-    if (argc < 3)
+    // 全局选项 --sha-impl <name>：批量命令使用的 SHA-256 实现
+    if (argc >= 3 && std::string(argv[1]) == "--sha-impl")
+    {
+        if (!sha256_impl_from_name(argv[2], g_sha_impl) || !sha256_impl_supported(g_sha_impl))
+        {
+            std::cerr << "不支持的SHA-256实现: " << argv[2] << "\n";
+            return 1;
+        }
+        argv += 2;
+        argc -= 2;
+    }
+    if (argc == 2 && std::string(argv[1]) == "--batch")
+    { // 每行一条命令，消息取行内剩余的全部内容（可含空格）
+        return run_batch([](const std::string &line)
+                         {
+            std::vector<std::string> args = split_fields(line, 2);
+            if (!args.empty() && (args[0] == "open-verify" || args[0] == "open-verify-file"))
+                args = split_fields(line, 4);
+            else if (!args.empty() && args[0] == "merkle-verify")
+                args = split_fields(line, 7);
+            else if (!args.empty() && (args[0] == "merkle-commit" || args[0] == "merkle-open"))
+                args = split_fields(line);
+            return run_command(args); });
+    }
+    if (argc < 3 && !(argc == 2 && std::string(argv[1]) == "bench-sha"))
     {
         std::cerr << "使用说明:\n"
                   << argv[0] << " commit <message>          # 创建承诺      Output: <commit_hex> <nonce_hex>\n"
-                  << argv[0] << " open-verify <commit_hex> <nonce_hex> <message>  # 验证承诺\n";
+                  << argv[0] << " open-verify <commit_hex> <nonce_hex> <message>  # 验证承诺\n"
+                  << argv[0] << " commit-file <path>        # 对文件内容创建承诺，输出同 commit，吞吐量(GB/s)输出到标准错误\n"
+                  << argv[0] << " open-verify-file <commit_hex> <nonce_hex> <path>  # 验证文件的承诺\n"
+                  << argv[0] << " commit-batch <file>       # 文件每行一条消息，多路SHA-256批量创建承诺，输出同 commit\n"
+                  << argv[0] << " verify-batch <file>       # 文件每行 <commit_hex> <nonce_hex> <message>，批量验证并列出无效行\n"
+                  << argv[0] << " merkle-commit <file> <out> # 文件每行一条消息，输出 Merkle 根 <root_hex> <n>，打开信息写入 out\n"
+                  << argv[0] << " merkle-open <out> <index...>  # 输出 <index> <nonce_hex> <path_hex> <message>\n"
+                  << argv[0] << " merkle-verify <root_hex> <n> <index> <nonce_hex> <path_hex> <message>  # 验证单条打开\n"
+                  << argv[0] << " bench-sha                 # 各SHA-256实现的批量吞吐\n"
+                  << argv[0] << " --batch                   # 从标准输入逐行读取上述命令（不含程序名），逐行输出结果\n"
+                  << "选项: --sha-impl <scalar|sha-ni|sse2|avx2|avx512|auto>  # 批量命令使用的SHA-256实现，默认自动选择\n";
         return 1;
     }
 
-    std::string cmd = argv[1]; // 获取命令参数（commit或open-verify）
-    if (cmd == "commit")
+    try
     {
-        do_commit(argv[2]);
-    }
-    else if (cmd == "open-verify" && argc == 5)
-    {
-        std::cout << (verify(argv[2], argv[3], argv[4]) ? "OK" : "FAIL") << std::endl;
+        if (!run_command(std::vector<std::string>(argv + 1, argv + argc)))
+        {
+            std::cerr << "参数错误\n";
+            return 1;
+        }
     }
-    else
+    catch (const std::exception &e)
     {
-        std::cerr << "参数错误\n";
+        std::cerr << e.what() << "\n";
         return 1;
     }
 
     return 0;
-}
\ No newline at end of file
+}
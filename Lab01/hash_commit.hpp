@@ -0,0 +1,249 @@
+#ifndef _hash_commit_hpp_
+#define _hash_commit_hpp_
+
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+#include <openssl/evp.h>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <stdexcept>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "batch.hpp"
+#include "hex.hpp"
+#include "merkle.hpp"
+#include "sha256_mb.hpp"
+
+// 哈希承诺方案：承诺与验证、多路 SHA-256 批量承诺、文件承诺与 Merkle 打开验证
+// 命令行程序（hash_commit.cpp）与 lab01_bench 共用；命名空间 hc 避免与另外两个方案的同名工具函数冲突
+namespace hc
+{
+// TODO: 学生需要实现此函数 - 将字节转换为十六进制字符串（作为工具函数）
+inline std::string to_hex(const std::vector<unsigned char> &buf)
+{
+    // 提示：可使用std::ostringstream和std::hex, std::setw, std::setfill
+    // 实现将字节向量转换为十六进制字符串
+    // 例如：{0x1, 0x2, 0xAB} 应该转换为 "0102ab"
+    // 你的代码在这里
+    using namespace std; 
+    {
+        ostringstream oss;
+        for (unsigned char byte : buf) {
+            oss << hex << setw(2) << setfill('0') << (int)byte;
+        }
+        return oss.str();
+    }
+}
+
+// TODO: 学生需要实现此函数 - 将十六进制字符串转换为字节（作为工具函数）
+inline std::vector<unsigned char> hex_to_bytes(const std::string &hex)
+{
+    // 提示：hex字符串每两个字符代表一个字节
+    // 例如："0102ab" 应该转换为 {0x1, 0x2, 0xAB}
+    // 你的代码在这里
+    using namespace std; 
+    {
+        vector<unsigned char> bytes;
+        for (size_t i = 0; i < hex.length(); i += 2) {
+            string byteString = hex.substr(i, 2);
+            unsigned char byte = (unsigned char) strtol(byteString.c_str(), nullptr, 16);
+            bytes.push_back(byte);
+        }
+        return bytes;
+    }
+}
+
+// TODO: 学生需要实现此函数 - 对数据进行SHA256哈希
+inline std::vector<unsigned char> sha256(const std::vector<unsigned char> &data)
+{
+    // 提示：使用OpenSSL的SHA256函数
+    // SHA256_DIGEST_LENGTH是哈希输出的长度
+    // 你的代码在这里
+    unsigned char hash[SHA256_DIGEST_LENGTH];
+    SHA256(data.data(),data.size(),hash);
+    std::vector<unsigned char> result;
+    result.insert(result.end(),hash,hash+SHA256_DIGEST_LENGTH);
+    return result;
+    // return {}; // 临时返回，学生需要替换
+}
+
+// TODO: 学生需要实现此函数 - 生成指定长度的安全随机数
+/// @brief 产生随机数
+/// @param len int_32 随机数长度
+/// @return rand_bytes int_32 随机数
+inline std::vector<unsigned char> generate_nonce(size_t len = 32)
+{
+    // 提示：使用OpenSSL的RAND_bytes函数生成随机数
+    // 你的代码在这里
+    std::vector<unsigned char> rand_bytes(len); 
+    RAND_bytes(rand_bytes.data(), len);
+    return rand_bytes;
+}
+
+// TODO: 学生需要实现此函数 - 计算承诺值，即SHA256(message || nonce)
+/// @brief 
+/// @param message ASCII明文字符串
+/// @param nonce bytes随机数
+/// @return 
+inline std::vector<unsigned char> commit(const std::string &message, const std::vector<unsigned char> &nonce)
+{
+    // 提示：将消息和随机数连接起来，然后计算SHA256哈希
+    // message需要先转换为字节向量
+    // 你的代码在这里
+    auto vec_message = std::vector<unsigned char>(message.begin(), message.end());
+    vec_message.insert(vec_message.end(), nonce.begin(), nonce.end());
+    auto res = sha256(vec_message);
+    return res;
+}
+
+// TODO: 学生需要实现此函数 - 验证承诺是否正确
+inline bool verify(const std::string &commit_hex, const std::string &nonce_hex, const std::string &message)
+{
+    // 提示：将十六进制字符串转换为字节向量(hex_to_bytes函数) ，重新计算承诺值，并比较
+    // 你的代码在这里
+    auto hex_message = std::vector<unsigned char>(message.begin(), message.end());
+    auto hex_commit = commit(message, hex_to_bytes(nonce_hex));
+    if (to_hex(hex_commit) == commit_hex) {
+        return true;
+    } else {
+        return false;
+    }
+}
+
+// 批量计算承诺值 SHA256(messages[i] || nonces[i])：多路 SHA-256 同时处理多条消息，不拼接、不逐条分配
+inline std::vector<std::vector<unsigned char>> commit_batch(const std::vector<std::string> &messages,
+                                                            const std::vector<std::vector<unsigned char>> &nonces,
+                                                            Sha256Impl impl = Sha256Impl::Auto)
+{
+    std::vector<Sha256Msg> msgs(messages.size());
+    for (size_t i = 0; i < messages.size(); ++i)
+        msgs[i] = {(const unsigned char *)messages[i].data(), messages[i].size(), nonces[i].data(), nonces[i].size()};
+    std::vector<std::vector<unsigned char>> out;
+    sha256_batch(msgs, out, impl);
+    return out;
+}
+
+// 批量验证：valid[i] 表示 commits[i] 是否等于 SHA256(messages[i] || nonces[i])
+inline std::vector<bool> verify_batch(const std::vector<std::vector<unsigned char>> &commits, const std::vector<std::string> &messages,
+                                      const std::vector<std::vector<unsigned char>> &nonces, Sha256Impl impl = Sha256Impl::Auto)
+{
+    std::vector<std::vector<unsigned char>> c = commit_batch(messages, nonces, impl);
+    std::vector<bool> valid(c.size());
+    for (size_t i = 0; i < c.size(); ++i)
+        valid[i] = c[i] == commits[i];
+    return valid;
+}
+
+// 流式计算文件的承诺值 SHA256(文件内容 || nonce)，bytes 返回读取的字节数
+// POSIX 下 mmap 整个文件（MADV_SEQUENTIAL 提示内核预读），按段直接送入 EVP 增量摘要，文件内容不经过任何复制；
+// Windows、空文件或无法 mmap（如管道）时以 4MB 块读取；只接受普通文件与管道，读取出错时抛出异常
+inline std::vector<unsigned char> commit_file(const std::string &path, const std::vector<unsigned char> &nonce, uint64_t &bytes)
+{
+    std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+    if (!ctx || EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr) != 1)
+        throw std::runtime_error("EVP_DigestInit_ex failed");
+    auto update = [&](const void *data, size_t len)
+    {
+        if (EVP_DigestUpdate(ctx.get(), data, len) != 1)
+            throw std::runtime_error("EVP_DigestUpdate failed");
+    };
+    bytes = 0;
+    bool mapped = false;
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("无法打开文件: " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !(S_ISREG(st.st_mode) || S_ISFIFO(st.st_mode)))
+    { // 目录等读不出内容，不能当作空文件承诺
+        close(fd);
+        throw std::runtime_error("不是普通文件或管道: " + path);
+    }
+    if (S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        size_t size = (size_t)st.st_size;
+        void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            madvise(map, size, MADV_SEQUENTIAL);
+            const size_t SEGMENT = (size_t)1 << 30; // EVP_DigestUpdate 的单次长度，避免超大文件时的长度溢出
+            const unsigned char *data = (const unsigned char *)map;
+            try
+            {
+                for (size_t off = 0; off < size; off += SEGMENT)
+                    update(data + off, std::min(SEGMENT, size - off));
+            }
+            catch (...)
+            {
+                munmap(map, size);
+                close(fd);
+                throw;
+            }
+            munmap(map, size);
+            bytes = size;
+            mapped = true;
+        }
+    }
+    close(fd);
+#endif
+    if (!mapped)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw std::runtime_error("无法打开文件: " + path);
+        std::vector<char> buf((size_t)4 << 20);
+        while (in.read(buf.data(), buf.size()) || in.gcount() > 0)
+        {
+            update(buf.data(), (size_t)in.gcount());
+            bytes += (uint64_t)in.gcount();
+        }
+        if (in.bad() || !in.eof())
+            throw std::runtime_error("读取文件失败: " + path);
+    }
+    update(nonce.data(), nonce.size());
+    std::vector<unsigned char> digest(SHA256_DIGEST_LENGTH);
+    unsigned int dlen = 0;
+    if (EVP_DigestFinal_ex(ctx.get(), digest.data(), &dlen) != 1 || dlen != digest.size())
+        throw std::runtime_error("EVP_DigestFinal_ex failed");
+    return digest;
+}
+
+// merkle-verify：验证第 index 条消息（共 n 条）的打开信息与认证路径得到公开的根
+inline bool merkle_open_verify(const std::string &root_hex, const std::string &n_str, const std::string &index_str,
+                               const std::string &nonce_hex, const std::string &path_hex, const std::string &message)
+{
+    std::vector<unsigned char> root, nonce, path;
+    size_t n, index, pos_n = 0, pos_i = 0;
+    try
+    {
+        n = std::stoull(n_str, &pos_n);
+        index = std::stoull(index_str, &pos_i);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    // 随机数必须恰为 32 字节：否则把消息末尾的字节挪到随机数前面（或反过来）时 SHA256 的输入不变，同一叶子可打开为别的消息
+    if (pos_n != n_str.size() || pos_i != index_str.size() || !hex_decode(root_hex, root) || root.size() != 32 ||
+        !hex_decode(nonce_hex, nonce) || nonce.size() != 32 || (path_hex != "-" && !hex_decode(path_hex, path)))
+        return false;
+    std::vector<unsigned char> leaf = commit(message, nonce);
+    return merkle_verify(root.data(), n, index, leaf.data(), path);
+}
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef _hex_hpp_
+#define _hex_hpp_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 查表的十六进制编解码，替代 istringstream / setw(2) 逐字节格式化
+// 编码每字节查一次 256 项表直接得到两个字符；解码每个字符查一次 256 项表，非法字符为 -1
+// 表在编译期生成，编码默认输出大写（lower 为 true 时小写），解码大小写都接受
+
+namespace hex_detail
+{
+    struct Tables
+    {
+        char enc[2][256][2]; // [小写][字节]
+        int8_t dec[256];
+
+        constexpr Tables() : enc(), dec()
+        {
+            const char digits[2][17] = {"0123456789ABCDEF", "0123456789abcdef"};
+            for (int i = 0; i < 256; ++i)
+            {
+                for (int lower = 0; lower < 2; ++lower)
+                {
+                    enc[lower][i][0] = digits[lower][i >> 4];
+                    enc[lower][i][1] = digits[lower][i & 0xF];
+                }
+                dec[i] = -1;
+            }
+            for (int i = 0; i < 10; ++i)
+                dec['0' + i] = (int8_t)i;
+            for (int i = 0; i < 6; ++i)
+            {
+                dec['a' + i] = (int8_t)(10 + i);
+                dec['A' + i] = (int8_t)(10 + i);
+            }
+        }
+    };
+
+    inline constexpr Tables tables{};
+}
+
+// len 字节 -> 2*len 个字符，写入 out（不追加 '\0'）
+inline void hex_encode(const unsigned char *data, size_t len, char *out, bool lower = false)
+{
+    const char(*enc)[2] = hex_detail::tables.enc[lower];
+    for (size_t i = 0; i < len; ++i)
+    {
+        out[2 * i] = enc[data[i]][0];
+        out[2 * i + 1] = enc[data[i]][1];
+    }
+}
+
+inline std::string hex_encode(const unsigned char *data, size_t len, bool lower = false)
+{
+    std::string s(2 * len, '0');
+    hex_encode(data, len, &s[0], lower);
+    return s;
+}
+
+// 2*len 个字符 -> len 字节，遇到非法字符返回 false
+inline bool hex_decode(const char *hex, size_t len, unsigned char *out)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        int hi = hex_detail::tables.dec[(unsigned char)hex[2 * i]];
+        int lo = hex_detail::tables.dec[(unsigned char)hex[2 * i + 1]];
+        if ((hi | lo) < 0)
+            return false;
+        out[i] = (unsigned char)(hi << 4 | lo);
+    }
+    return true;
+}
+
+// 奇数长度或含非法字符时返回 false
+inline bool hex_decode(const std::string &hex, std::vector<unsigned char> &out)
+{
+    if (hex.size() % 2)
+        return false;
+    out.resize(hex.size() / 2);
+    return hex_decode(hex.data(), out.size(), out.data());
+}
+
+#endif // _hex_hpp_
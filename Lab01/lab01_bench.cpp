@@ -0,0 +1,314 @@
+// lab01_bench：在进程内直接调用哈希承诺、Pedersen承诺与Shamir秘密分享的方案代码，
+// 按参数（消息长度、批大小、t、n）扫描，报告吞吐（ops/s）、单次调用的 p50/p99 延迟与每个操作的内存分配次数
+// 方案代码来自各自的头文件（命名空间 hc、ped、sh），与命令行程序共用
+#include <openssl/crypto.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hash_commit.hpp"
+#include "pedersen.hpp"
+#include "shamir.hpp"
+
+// 内存分配计数：替换全局 operator new，并通过 CRYPTO_set_mem_functions 统计 OpenSSL 内部的分配
+static std::atomic<uint64_t> g_allocs{0};
+
+// 不内联：否则 GCC 把内联后的 malloc/free 与 new/delete 交叉配对，报 -Wmismatched-new-delete
+__attribute__((noinline)) void *operator new(size_t size)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+static void *counting_malloc(size_t size, const char *, int)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size);
+}
+
+static void *counting_realloc(void *p, size_t size, const char *, int)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    return std::realloc(p, size);
+}
+
+static void counting_free(void *p, const char *, int) { std::free(p); }
+
+struct BenchResult
+{
+    std::string name;
+    std::vector<std::pair<std::string, long long>> params;
+    size_t batch;  // 每次调用完成的操作数
+    size_t calls;  // 计时的调用次数
+    double ops_per_sec;
+    double p50_ns; // 单次调用（一批）的延迟
+    double p99_ns;
+    double allocs_per_op;
+};
+
+struct BenchOptions
+{
+    double min_sec = 0.5; // 每项至少运行的时间
+    size_t min_calls = 10;
+    std::string filter;   // 只运行名称包含该子串的项
+};
+
+static std::vector<BenchResult> g_results;
+
+// 先预热一次，再反复调用 op 直到累计时间与次数都达到下限；每次调用单独计时
+static void run_bench(const BenchOptions &opt, const std::string &name,
+                      const std::vector<std::pair<std::string, long long>> &params, size_t batch,
+                      const std::function<void()> &op)
+{
+    if (name.find(opt.filter) == std::string::npos)
+        return;
+    op();
+    std::vector<double> lat;
+    double total = 0;
+    uint64_t allocs = 0;
+    while (total < opt.min_sec || lat.size() < opt.min_calls)
+    {
+        // 只统计 op() 本身的分配，不含 lat 扩容
+        uint64_t before = g_allocs.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        op();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        allocs += g_allocs.load(std::memory_order_relaxed) - before;
+        lat.push_back(ns);
+        total += ns / 1e9;
+    }
+
+    BenchResult r;
+    r.name = name;
+    r.params = params;
+    r.batch = batch;
+    r.calls = lat.size();
+    r.ops_per_sec = lat.size() * batch / total;
+    std::sort(lat.begin(), lat.end());
+    r.p50_ns = lat[lat.size() / 2];
+    r.p99_ns = lat[std::min(lat.size() - 1, lat.size() * 99 / 100)];
+    r.allocs_per_op = (double)allocs / (lat.size() * batch);
+    g_results.push_back(r);
+
+    std::string p;
+    for (auto &kv : params)
+        p += kv.first + "=" + std::to_string(kv.second) + " ";
+    std::cout << std::left << std::setw(28) << name << std::setw(22) << p << std::right << std::fixed
+              << std::setprecision(0) << std::setw(14) << r.ops_per_sec << std::setw(14) << r.p50_ns << std::setw(14)
+              << r.p99_ns << std::setprecision(2) << std::setw(12) << r.allocs_per_op << "\n";
+}
+
+static void bench_hash_commit(const BenchOptions &opt)
+{
+    std::vector<unsigned char> nonce = hc::generate_nonce();
+    for (long long len : {32, 1024})
+    {
+        std::string message(len, 'm');
+        run_bench(opt, "hash_commit/commit", {{"len", len}}, 1, [&] { hc::commit(message, nonce); });
+        // 承诺值与随机数的十六进制在计时外准备好，只计 verify 本身
+        std::string commit_hex = hc::to_hex(hc::commit(message, nonce)), nonce_hex = hc::to_hex(nonce);
+        run_bench(opt, "hash_commit/verify", {{"len", len}}, 1, [&]
+                  {
+            if (!hc::verify(commit_hex, nonce_hex, message))
+                throw std::runtime_error("验证失败"); });
+    }
+    for (long long batch : {1, 64, 4096})
+    {
+        std::vector<std::string> messages(batch, std::string(32, 'm'));
+        std::vector<std::vector<unsigned char>> nonces(batch, nonce);
+        run_bench(opt, "hash_commit/commit_batch", {{"len", 32}, {"batch", batch}}, batch,
+                  [&] { hc::commit_batch(messages, nonces); });
+    }
+}
+
+static void bench_pedersen(const BenchOptions &opt)
+{
+    ped::PedersenParams params = ped::init_pedersen_params();
+    ped::PedersenCommitResult c = ped::create_pedersen_commitment(params, "rand");
+    run_bench(opt, "pedersen/commit", {}, 1, [&]
+              { ec_to_affine(ped::pedersen_commit(params, c.message, c.randomness)); });
+    run_bench(opt, "pedersen/verify", {}, 1, [&] { ped::pedersen_verify(params, c.commitment, c.message, c.randomness); });
+
+    for (long long batch : {16, 256, 4096})
+    {
+        std::vector<ped::PedersenOpening> ops(batch);
+        for (long long i = 0; i < batch; ++i)
+        {
+            ped::PedersenCommitResult o = ped::create_pedersen_commitment(params, "rand");
+            ops[i].line = i + 1;
+            ops[i].C = o.commitment;
+            ops[i].m = ped::Scalar::from_bn(o.message);
+            ops[i].r = ped::Scalar::from_bn(o.randomness);
+            BN_free(o.message);
+            BN_free(o.randomness);
+        }
+        run_bench(opt, "pedersen/verify_batch", {{"batch", batch}}, batch, [&]
+                  {
+            if (!ped::PedersenBatchVerifier(params, ops).invalid().empty())
+                throw std::runtime_error("批量验证失败"); });
+    }
+    BN_free(c.message);
+    BN_free(c.randomness);
+    ped::free_pedersen_params(params);
+}
+
+static void bench_shamir(const BenchOptions &opt)
+{
+    BIGNUM *prime = sh::hex_to_bn("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+    for (auto tn : {std::make_pair(3, 5), std::make_pair(10, 100), std::make_pair(50, 1000), std::make_pair(200, 2000)})
+    {
+        int t = tn.first, n = tn.second;
+        auto [secret, coeffs] = sh::generate_secret_and_coeffs(prime, "rand", t);
+        run_bench(opt, "shamir/share", {{"t", t}, {"n", n}}, 1, [&]
+                  {
+            for (auto &s : sh::generate_shares(prime, coeffs, n))
+                BN_free(s.second); });
+
+        std::vector<std::pair<int, BIGNUM *>> shares = sh::generate_shares(prime, coeffs, n);
+        std::vector<std::pair<int, BIGNUM *>> quorum(shares.begin(), shares.begin() + t);
+        std::vector<std::pair<BIGNUM *, BIGNUM *>> points;
+        for (auto &s : quorum)
+        {
+            BIGNUM *x = BN_new();
+            BN_set_word(x, s.first);
+            points.push_back({x, s.second});
+        }
+        auto check = [&](BIGNUM *r)
+        {
+            bool ok = BN_cmp(r, secret) == 0;
+            BN_free(r);
+            if (!ok)
+                throw std::runtime_error("重构结果错误");
+        };
+        // 缓存了同一组份额持有者的拉格朗日系数（重复重构同一集合）
+        run_bench(opt, "shamir/reconstruct", {{"t", t}, {"n", n}}, 1, [&] { check(sh::reconstruct_secret(prime, quorum)); });
+        // 无缓存：每次重新计算全部基函数
+        run_bench(opt, "shamir/reconstruct_cold", {{"t", t}, {"n", n}}, 1, [&]
+                  { check(sh::lagrange_reconstruct_at_zero(points, prime)); });
+
+        for (auto &p : points)
+            BN_free(p.first);
+        for (auto &s : shares)
+            BN_free(s.second);
+        for (auto c : coeffs)
+            BN_free(c);
+        BN_free(secret);
+    }
+    BN_free(prime);
+}
+
+static std::string json_escape(const std::string &s)
+{
+    std::string out;
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+static void write_json(std::ostream &out)
+{
+    out << "{\n  \"sha256_impl\": \"" << sha256_impl_name(sha256_best_impl()) << "\",\n"
+        << "  \"openssl\": \"" << json_escape(OpenSSL_version(OPENSSL_VERSION)) << "\",\n"
+        << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < g_results.size(); ++i)
+    {
+        const BenchResult &r = g_results[i];
+        out << "    {\"name\": \"" << json_escape(r.name) << "\", \"params\": {";
+        for (size_t j = 0; j < r.params.size(); ++j)
+            out << (j ? ", " : "") << "\"" << r.params[j].first << "\": " << r.params[j].second;
+        out << "}, \"batch\": " << r.batch << ", \"calls\": " << r.calls << std::fixed << std::setprecision(1)
+            << ", \"ops_per_sec\": " << r.ops_per_sec << ", \"p50_ns\": " << r.p50_ns << ", \"p99_ns\": " << r.p99_ns
+            << std::setprecision(3) << ", \"allocs_per_op\": " << r.allocs_per_op << "}"
+            << (i + 1 < g_results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char **argv)
+{
+    // 须在 OpenSSL 的第一次分配之前设置
+    CRYPTO_set_mem_functions(counting_malloc, counting_realloc, counting_free);
+
+    BenchOptions opt;
+    std::string json_path;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        if (a == "--json" && i + 1 < argc)
+            json_path = argv[++i];
+        else if (a == "--filter" && i + 1 < argc)
+            opt.filter = argv[++i];
+        else if (a == "--quick")
+        {
+            opt.min_sec = 0.01;
+            opt.min_calls = 3;
+        }
+        else
+        {
+            std::cerr << "使用说明:\n"
+                      << argv[0] << " [--quick] [--filter <子串>] [--json <file|->]\n"
+                      << "  --quick            # 每项只运行约10ms（用于冒烟测试）\n"
+                      << "  --filter <子串>    # 只运行名称包含该子串的项，如 pedersen/\n"
+                      << "  --json <file|->    # 结果另以JSON写入文件（- 为标准输出，此时不输出表格），用于回归对比\n";
+            return 1;
+        }
+    }
+    std::ostringstream table_sink;
+    std::streambuf *cout_buf = nullptr;
+    if (json_path == "-")
+        cout_buf = std::cout.rdbuf(table_sink.rdbuf());
+
+    std::cout << std::left << std::setw(28) << "name" << std::setw(22) << "params" << std::right << std::setw(14)
+              << "ops/s" << std::setw(14) << "p50(ns)" << std::setw(14) << "p99(ns)" << std::setw(12) << "allocs/op"
+              << "\n";
+    try
+    {
+        bench_hash_commit(opt);
+        bench_pedersen(opt);
+        bench_shamir(opt);
+    }
+    catch (const std::exception &e)
+    {
+        if (cout_buf)
+            std::cout.rdbuf(cout_buf);
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    if (cout_buf)
+    {
+        std::cout.rdbuf(cout_buf);
+        write_json(std::cout);
+    }
+    else if (!json_path.empty())
+    {
+        std::ofstream out(json_path);
+        if (!out)
+        {
+            std::cerr << "无法写入文件: " << json_path << "\n";
+            return 1;
+        }
+        write_json(out);
+    }
+    return 0;
+}
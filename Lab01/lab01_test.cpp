@@ -1,4 +1,5 @@
 #include <iostream>
+#include <fstream>
 #include <cstdlib>
 #include <sstream>
 #include <string>
@@ -89,9 +90,438 @@ bool test_pedersen()
     return verify_out.find("OK") != std::string::npos;
 }
 
-bool test_shamir()
+// 负数消息按群阶约化到 [0, 群阶)：commit -0A 能生成承诺，verify 用 -0A 打开成功，用 0A 打开失败
+bool test_pedersen_negative()
 {
-    std::string cmd = std::string(".") + PATH_SEP + EXE_NAME("shamir") + " share rand 3 5";
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("pedersen");
+    auto tokens = split(run_cmd(exe + " commit -0A"));
+    if (tokens.size() != 3)
+    {
+        std::cerr << "pedersen negative commit fail\n";
+        return false;
+    }
+    std::string ok = run_cmd(exe + " verify " + tokens[0] + " -0A " + tokens[2]);
+    std::string bad = run_cmd(exe + " verify " + tokens[0] + " 0A " + tokens[2]);
+    return ok == "OK\n" && bad == "FAIL\n";
+}
+
+// 预计算表缓存被改动（交换两列的最后一项，仍都是曲线上的点）时应被拒绝并重建，承诺仍然正确
+bool test_pedersen_tables()
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("pedersen");
+    std::string path = "pedersen_tables_test";
+    run_cmd(exe + " --tables " + path + " commit rand");
+    std::string original;
+    {
+        std::ifstream in(path + ".G", std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const size_t head = 41, entry = 64, digits = 255; // 文件头、表项大小、每列表项数，与 EcFixedBase 一致
+    if (original.size() != head + entry * digits * 32)
+    {
+        std::cerr << "pedersen tables: cache not written\n";
+        return false;
+    }
+    std::string tampered = original;
+    std::swap_ranges(tampered.begin() + head + entry * (digits - 1), tampered.begin() + head + entry * digits,
+                     tampered.begin() + head + entry * (2 * digits - 1));
+    std::ofstream(path + ".G", std::ios::binary | std::ios::trunc) << tampered;
+
+    auto tokens = split(run_cmd(exe + " --tables " + path + " commit FF"));
+    std::string restored;
+    {
+        std::ifstream in(path + ".G", std::ios::binary);
+        restored.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::remove((path + ".G").c_str());
+    std::remove((path + ".H").c_str());
+    if (tokens.size() != 3)
+    {
+        std::cerr << "pedersen tables: commit fail\n";
+        return false;
+    }
+    std::string verify_out = run_cmd(exe + " verify " + tokens[0] + " FF " + tokens[2]);
+    return verify_out == "OK\n" && restored == original;
+}
+
+// 测试 --batch 模式：一个进程内完成 count 次承诺，再用另一个批次逐行验证
+// 输入写入临时文件后重定向到标准输入，每行输出与每行输入一一对应
+bool test_batch(const std::string &tool, int count = 1000)
+{
+    std::string exe = std::string(".") + PATH_SEP + tool + EXE_NAME("") + " --batch < " + tool + "_batch_test.txt";
+    {
+        std::ofstream f(tool + "_batch_test.txt");
+        for (int i = 0; i < count; ++i)
+            f << (tool == "pedersen" ? "commit rand" : "commit batch message " + std::to_string(i)) << "\n";
+    }
+    std::istringstream commits(run_cmd(exe));
+    {
+        std::ofstream f(tool + "_batch_test.txt");
+        std::string line;
+        for (int i = 0; std::getline(commits, line); ++i)
+            f << (tool == "pedersen" ? "verify " + line : "open-verify " + line + " batch message " + std::to_string(i)) << "\n";
+    }
+    std::vector<std::string> results = split(run_cmd(exe));
+    std::remove((tool + "_batch_test.txt").c_str());
+    return results.size() == (size_t)count && std::count(results.begin(), results.end(), "OK") == count;
+}
+
+// 测试 shamir --batch：一个批次生成 count 组份额，另一个批次逐组用后 t 个份额重构，中间夹一条格式错误的命令
+// 每条命令的输出以空行结束；错误的命令只输出一行 ERROR，不影响后续命令
+bool test_shamir_batch(int count = 50, int t = 3, int n = 5)
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("shamir") + " --batch < shamir_batch_test.txt";
+    auto blocks = [&](const std::string &out)
+    {
+        std::vector<std::vector<std::string>> bs(1);
+        std::istringstream iss(out);
+        std::string line;
+        while (std::getline(iss, line))
+        {
+            if (line.empty())
+                bs.emplace_back();
+            else
+                bs.back().push_back(line);
+        }
+        bs.pop_back(); // 最后一个空行之后没有输出
+        return bs;
+    };
+    {
+        std::ofstream f("shamir_batch_test.txt");
+        for (int i = 0; i < count; ++i)
+            f << "share rand " << t << " " << n << "\n";
+    }
+    auto shared = blocks(run_cmd(exe));
+    bool ok = shared.size() == (size_t)count;
+    for (auto &b : shared)
+        ok = ok && b.size() == (size_t)n + 1;
+    if (ok)
+    {
+        std::ofstream f("shamir_batch_test.txt");
+        for (int i = 0; i < count; ++i)
+        {
+            if (i == count / 2)
+                f << "reconstruct 1:zz 2:11\n";
+            f << "reconstruct";
+            for (int j = n - t + 1; j <= n; ++j)
+                f << " " << shared[i][j];
+            f << "\n";
+        }
+    }
+    auto rec = ok ? blocks(run_cmd(exe)) : decltype(shared)();
+    std::remove("shamir_batch_test.txt");
+    if (!ok || rec.size() != (size_t)count + 1)
+        return false;
+    for (int i = 0, r = 0; i < count; ++i, ++r)
+    {
+        if (i == count / 2 && !(rec[r++] == std::vector<std::string>{"ERROR 参数错误"}))
+            return false;
+        if (rec[r] != std::vector<std::string>{shared[i][0]})
+            return false;
+    }
+    return true;
+}
+
+// 批量验证：生成 count 个承诺写入文件，先验证全部通过，再篡改若干行的 m 检查能否定位
+bool test_pedersen_verify_batch(int count = 300)
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("pedersen");
+    {
+        std::ofstream f("pedersen_vb_test.txt");
+        for (int i = 0; i < count; ++i)
+            f << "commit rand\n";
+    }
+    std::vector<std::string> lines;
+    {
+        std::istringstream commits(run_cmd(exe + " --batch < pedersen_vb_test.txt"));
+        std::string line;
+        while (std::getline(commits, line))
+            lines.push_back(line);
+    }
+    if (lines.size() != (size_t)count)
+    {
+        std::remove("pedersen_vb_test.txt");
+        return false;
+    }
+    auto write_and_verify = [&](const std::vector<std::string> &ls)
+    {
+        std::ofstream f("pedersen_vb_test.txt");
+        f << "# C m r\n"; // 注释行也计入行号
+        for (auto &l : ls)
+            f << l << "\n";
+        f.close();
+        return run_cmd(exe + " verify-batch pedersen_vb_test.txt");
+    };
+    bool ok = write_and_verify(lines) == "OK " + std::to_string(count) + "\n";
+
+    std::vector<int> bad = {3, count / 2, count - 1};
+    std::string expected = "FAIL " + std::to_string(bad.size()) + "/" + std::to_string(count) + "\n无效的行:";
+    for (int i : bad)
+    {
+        std::vector<std::string> f = split(lines[i]);
+        lines[i] = f[0] + " " + f[1] + "1 " + f[2]; // 篡改 m
+        expected += " " + std::to_string(i + 2);
+    }
+    ok = ok && write_and_verify(lines) == expected + "\n";
+    std::remove("pedersen_vb_test.txt");
+    return ok;
+}
+
+// 向量承诺：正确打开通过，交换两个分量或篡改任一分量都应失败
+bool test_pedersen_vector(int len = 40)
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("pedersen");
+    std::mt19937_64 rng{std::random_device{}()};
+    std::vector<std::string> m(len);
+    for (auto &x : m)
+    {
+        std::ostringstream oss;
+        oss << std::hex << rng() << rng();
+        x = oss.str();
+    }
+    auto join = [](const std::vector<std::string> &v)
+    {
+        std::string s;
+        for (auto &x : v)
+            s += " " + x;
+        return s;
+    };
+    std::vector<std::string> out = split(run_cmd(exe + " vector-commit" + join(m)));
+    if (out.size() != 2)
+        return false;
+    std::string verify = exe + " vector-verify " + out[0] + " " + out[1];
+    bool ok = run_cmd(verify + join(m)) == "OK\n";
+    std::vector<std::string> swapped = m;
+    std::swap(swapped[0], swapped[len - 1]);
+    ok = ok && run_cmd(verify + join(swapped)) == "FAIL\n";
+    std::vector<std::string> tampered = m;
+    tampered[len / 2] += "1";
+    return ok && run_cmd(verify + join(tampered)) == "FAIL\n";
+}
+
+// 同态聚合：aggregate 与 commit-add 结果一致，2*C == C + C，C + (n-1)*C 为无穷远点
+bool test_pedersen_aggregate(int count = 200)
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("pedersen");
+    {
+        std::ofstream f("pedersen_agg_test.txt");
+        for (int i = 0; i < count; ++i)
+            f << "commit rand\n";
+    }
+    std::string commits = run_cmd(exe + " --batch < pedersen_agg_test.txt");
+    std::vector<std::string> points;
+    {
+        std::ofstream f("pedersen_agg_test.txt");
+        std::istringstream iss(commits);
+        std::string line;
+        while (std::getline(iss, line))
+        {
+            points.push_back(split(line)[0]);
+            f << (points.size() % 2 ? line : points.back()) << "\n"; // 整行或只有C点都应接受
+        }
+    }
+    if (points.size() != (size_t)count)
+        return false;
+    std::string add_cmd = exe + " commit-add";
+    for (auto &P : points)
+        add_cmd += " " + P;
+    std::vector<std::string> agg = split(run_cmd(exe + " aggregate pedersen_agg_test.txt"));
+    std::remove("pedersen_agg_test.txt");
+    bool ok = agg.size() == 2 && agg[1] == std::to_string(count) && run_cmd(add_cmd) == agg[0] + "\n";
+
+    std::string C = points[0];
+    ok = ok && run_cmd(exe + " commit-scale " + C + " 2") == run_cmd(exe + " commit-add " + C + " " + C);
+    std::string neg = split(run_cmd(exe + " commit-scale " + C + " FFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632550"))[0];
+    return ok && run_cmd(exe + " commit-add " + C + " " + neg) == "00\n";
+}
+
+// 批量创建承诺（共享求逆编码）：输出逐行可由 verify 与 verify-batch 验证，非法消息报告行号
+bool test_pedersen_commit_batch(int count = 500)
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("pedersen");
+    {
+        std::ofstream f("pedersen_cb_test.txt");
+        for (int i = 0; i < count; ++i)
+            f << (i % 3 ? "rand" : std::to_string(i)) << "\n";
+    }
+    std::string commits = run_cmd(exe + " commit-batch pedersen_cb_test.txt");
+    {
+        std::ofstream f("pedersen_cb_test.txt");
+        f << commits;
+    }
+    bool ok = run_cmd(exe + " verify-batch pedersen_cb_test.txt") == "OK " + std::to_string(count) + "\n";
+    {
+        std::ofstream f("pedersen_cb_test.txt");
+        std::istringstream iss(commits);
+        std::string line;
+        for (int i = 0; i < 10 && std::getline(iss, line); ++i)
+            f << "verify " << line << "\n";
+        f << "verify zz 1 2\n";
+    }
+    std::vector<std::string> results = split(run_cmd(exe + " --batch < pedersen_cb_test.txt"));
+    ok = ok && results.size() == 12 && std::count(results.begin(), results.begin() + 10, "OK") == 10 && results[10] == "ERROR";
+    {
+        std::ofstream f("pedersen_cb_test.txt");
+        f << "rand\nxyz\n";
+    }
+    ok = ok && run_cmd(exe + " commit-batch pedersen_cb_test.txt 2>&1").find("第 2 行") != std::string::npos;
+    std::remove("pedersen_cb_test.txt");
+    return ok;
+}
+
+// 多路 SHA-256 批量承诺：CPU 支持的每种实现各用 commit-batch 创建一批承诺，
+// 逐行交给 open-verify（OpenSSL 的单条路径）交叉验证，各实现共有的填充错误也能发现；
+// 再用同一实现的 verify-batch 验证，篡改与格式错误的行被报告。消息长度覆盖单块、多块与填充边界
+bool test_hash_commit_batch(int count = 1000)
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("hash_commit");
+    std::vector<std::string> messages;
+    {
+        std::ofstream f("hash_cb_test.txt");
+        for (int i = 0; i < count; ++i)
+        {
+            messages.push_back("msg" + std::string(i % 150, 'x') + std::to_string(i));
+            f << messages.back() << "\n";
+        }
+    }
+    auto write_lines = [](const std::vector<std::string> &lines, const std::string &prefix)
+    {
+        std::ofstream f("hash_cb_test.lines");
+        for (const std::string &line : lines)
+            f << prefix << line << "\n";
+    };
+    bool ok = true;
+    for (const char *impl : {"scalar", "sse2", "avx2", "sha-ni", "avx512"})
+    {
+        std::string options = std::string(" --sha-impl ") + impl;
+        std::string out = run_cmd(exe + options + " commit-batch hash_cb_test.txt 2>&1");
+        if (out.find("不支持的SHA-256实现") != std::string::npos)
+            continue; // 本机 CPU 不支持（scalar 总是支持）
+        std::istringstream commits(out);
+        std::vector<std::string> lines;
+        std::string c, r;
+        for (int i = 0; i < count && commits >> c >> r; ++i)
+            lines.push_back(c + " " + r + " " + messages[i]);
+        if ((int)lines.size() != count)
+        {
+            ok = false;
+            break;
+        }
+        write_lines(lines, "open-verify ");
+        std::vector<std::string> opened = split(run_cmd(exe + " --batch < hash_cb_test.lines"));
+        bool cross = opened.size() == (size_t)count && std::count(opened.begin(), opened.end(), "OK") == count;
+        write_lines(lines, "");
+        bool batch = run_cmd(exe + options + " verify-batch hash_cb_test.lines") == "OK " + std::to_string(count) + "\n";
+        lines[1].back() ^= 1; // 篡改消息
+        lines[3] = "zz";      // 格式错误
+        write_lines(lines, "");
+        bool located = run_cmd(exe + options + " verify-batch hash_cb_test.lines") ==
+                       "FAIL 2/" + std::to_string(count) + "\n无效的行: 2 4\n";
+        if (!(cross && batch && located))
+        {
+            std::cerr << "hash_commit commit-batch failed with --sha-impl " << impl << "\n";
+            ok = false;
+        }
+    }
+    std::remove("hash_cb_test.txt");
+    std::remove("hash_cb_test.lines");
+    return ok;
+}
+
+// Merkle 批量承诺：奇数个叶子（末尾节点被提升）的打开均可验证，篡改消息或下标失败，各 SHA-256 实现的认证路径一致
+bool test_hash_merkle(int count = 1001)
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("hash_commit");
+    {
+        std::ofstream f("hash_merkle_test.txt");
+        for (int i = 0; i < count; ++i)
+            f << "msg " << i << "\n";
+    }
+    std::vector<std::string> root = split(run_cmd(exe + " merkle-commit hash_merkle_test.txt hash_merkle_test.open"));
+    if (root.size() != 2 || root[1] != std::to_string(count))
+        return false;
+    std::string indices = " 0 1 500 " + std::to_string(count - 1);
+    std::string openings = run_cmd(exe + " merkle-open hash_merkle_test.open" + indices);
+    bool ok = openings == run_cmd(exe + " --sha-impl scalar merkle-open hash_merkle_test.open" + indices);
+    std::istringstream iss(openings);
+    std::string index, nonce, path, word, message;
+    int opened = 0;
+    while (iss >> index >> nonce >> path >> word >> message)
+    {
+        std::string verify = exe + " merkle-verify " + root[0] + " " + root[1] + " ";
+        ok = ok && run_cmd(verify + index + " " + nonce + " " + path + " \"msg " + message + "\"") == "OK\n";
+        ok = ok && run_cmd(verify + index + " " + nonce + " " + path + " \"msg x" + message + "\"") == "FAIL\n";
+        ok = ok && run_cmd(verify + (index == "0" ? "2" : "0") + " " + nonce + " " + path + " \"msg " + message + "\"") == "FAIL\n";
+        // 消息的最后一个字节挪到随机数前面：SHA256 的输入不变，只能靠随机数长度检查拒绝
+        const char *HEX = "0123456789abcdef";
+        unsigned char last = (unsigned char)message.back();
+        ok = ok && run_cmd(verify + index + " " + HEX[last >> 4] + HEX[last & 15] + nonce + " " + path + " \"msg " +
+                           message.substr(0, message.size() - 1) + "\"") == "FAIL\n";
+        ++opened;
+    }
+    {
+        std::ofstream f("hash_merkle_test.txt");
+        f << "single\n";
+    }
+    root = split(run_cmd(exe + " merkle-commit hash_merkle_test.txt hash_merkle_test.open"));
+    std::vector<std::string> single = split(run_cmd(exe + " merkle-open hash_merkle_test.open 0"));
+    ok = ok && single.size() == 4 && single[2] == "-" &&
+         run_cmd(exe + " merkle-verify " + root[0] + " 1 0 " + single[1] + " - single") == "OK\n";
+    std::remove("hash_merkle_test.txt");
+    std::remove("hash_merkle_test.open");
+    return ok && opened == 4;
+}
+
+// 文件承诺：与同内容消息的 commit 一致；大文件篡改一个字节后验证失败；空文件可承诺
+bool test_hash_commit_file()
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("hash_commit");
+    auto write = [](const std::string &content)
+    {
+        std::ofstream f("hash_file_test.bin", std::ios::binary);
+        f << content;
+    };
+    write("hello file");
+    std::vector<std::string> out = split(run_cmd(exe + " commit-file hash_file_test.bin"));
+    bool ok = out.size() == 2 && run_cmd(exe + " open-verify " + out[0] + " " + out[1] + " \"hello file\"") == "OK\n";
+
+    std::string big(5 << 20, '\0');
+    for (size_t i = 0; i < big.size(); ++i)
+        big[i] = (char)(i * 2654435761u >> 13);
+    write(big);
+    out = split(run_cmd(exe + " commit-file hash_file_test.bin"));
+    ok = ok && out.size() == 2 && run_cmd(exe + " open-verify-file " + out[0] + " " + out[1] + " hash_file_test.bin") == "OK\n";
+    big[big.size() / 2] ^= 1;
+    write(big);
+    ok = ok && out.size() == 2 && run_cmd(exe + " open-verify-file " + out[0] + " " + out[1] + " hash_file_test.bin") == "FAIL\n";
+
+    write("");
+    out = split(run_cmd(exe + " commit-file hash_file_test.bin"));
+    ok = ok && out.size() == 2 && run_cmd(exe + " open-verify-file " + out[0] + " " + out[1] + " hash_file_test.bin") == "OK\n";
+
+    // 目录读不出内容：只报错（"...: ."），不能输出对空内容的承诺
+    std::string dir = run_cmd(exe + " commit-file . 2>&1");
+    ok = ok && dir.find(": .") != std::string::npos && dir.find("GB/s") == std::string::npos;
+    std::remove("hash_file_test.bin");
+    return ok;
+}
+
+// 基准程序冒烟测试：--quick 下 hash_commit 各项都写出 JSON 记录
+bool test_bench_json()
+{
+    std::string json = run_cmd(std::string(".") + PATH_SEP + EXE_NAME("lab01_bench") + " --quick --filter hash_commit/ --json -");
+    size_t records = 0;
+    for (size_t pos = 0; (pos = json.find("\"ops_per_sec\": ", pos)) != std::string::npos; ++pos)
+        ++records;
+    return json.find("\"benchmarks\": [") != std::string::npos && records == 7 && json.back() == '\n';
+}
+
+// options 为附加的全局选项（如 "--threads 4"），同时用于分享与重构
+bool test_shamir(int t = 3, int n = 5, const std::string &options = "")
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("shamir") + options;
+    std::string cmd = exe + " share rand " +
+                      std::to_string(t) + " " + std::to_string(n);
     std::string out = run_cmd(cmd);
     std::istringstream iss(out);
     std::string secret_hex;
@@ -102,7 +532,7 @@ bool test_shamir()
     while (std::getline(iss, line))
         if (!line.empty())
             shares.push_back(line);
-    if (shares.size() != 5)
+    if (shares.size() != (size_t)n)
     {
         std::cerr << "shamir share output parse fail\n";
         return false;
@@ -114,8 +544,7 @@ bool test_shamir()
     std::shuffle(indices.begin(), indices.end(),
                  std::mt19937{std::random_device{}()});
 
-    int t = 3;
-    std::string rec_cmd = std::string(".") + PATH_SEP + EXE_NAME("shamir") + " reconstruct";
+    std::string rec_cmd = exe + " reconstruct";
     for (int i = 0; i < t; ++i)
         rec_cmd += " " + shares[indices[i]];
 
@@ -126,18 +555,194 @@ bool test_shamir()
     return secret_hex == rec_hex;
 }
 
+// 测试按字节(GF(2^8))的文件分享：任意3个份额文件应还原出原文件
+bool test_shamir_file()
+{
+    std::mt19937 rng{std::random_device{}()};
+    std::string data(100003, '\0'); // 非块大小整数倍，覆盖尾块
+    for (auto &c : data)
+        c = (char)(rng() & 0xFF);
+    {
+        std::ofstream f("shamir_file_test.bin", std::ios::binary);
+        f.write(data.data(), data.size());
+    }
+
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("shamir");
+    std::string out = run_cmd(exe + " share-file shamir_file_test.bin 3 5 shamir_file_test.share");
+    if (split(out).size() != 5)
+    {
+        std::cerr << "shamir share-file output parse fail\n";
+        return false;
+    }
+    run_cmd(exe + " reconstruct-file shamir_file_test.out shamir_file_test.share.5 shamir_file_test.share.2 shamir_file_test.share.4");
+
+    std::ifstream f("shamir_file_test.out", std::ios::binary);
+    std::string rec((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    f.close();
+
+    std::remove("shamir_file_test.bin");
+    std::remove("shamir_file_test.out");
+    for (int i = 1; i <= 5; ++i)
+        std::remove(("shamir_file_test.share." + std::to_string(i)).c_str());
+    return rec == data;
+}
+
+// 测试打包分享：k 个秘密共用一组份额，任取 k+t-1 个份额应按原顺序还原全部秘密，少一个份额时应拒绝重构
+bool test_shamir_packed(int k = 40, int t = 3, int n = 50)
+{
+    std::mt19937_64 rng{std::random_device{}()};
+    std::vector<std::string> secrets;
+    {
+        std::ofstream f("shamir_packed_test.txt");
+        for (int i = 0; i < k; ++i)
+        {
+            std::ostringstream hex;
+            hex << std::hex << std::uppercase << (rng() >> 1) << (rng() | 1); // 128位以内，已在域内，无前导零
+            secrets.push_back(hex.str());
+            f << secrets.back() << "\n";
+        }
+    }
+
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("shamir");
+    std::vector<std::string> out = split(run_cmd(exe + " share-packed shamir_packed_test.txt " +
+                                                 std::to_string(t) + " " + std::to_string(n)));
+    std::remove("shamir_packed_test.txt");
+    if (out.size() != (size_t)n + 1 || out[0] != std::to_string(k))
+    {
+        std::cerr << "shamir share-packed output parse fail\n";
+        return false;
+    }
+
+    std::vector<std::string> shares(out.begin() + 1, out.end());
+    std::shuffle(shares.begin(), shares.end(), rng);
+    std::string rec_cmd = exe + " reconstruct-packed " + std::to_string(k) + " " + std::to_string(t);
+    for (int i = 0; i < k + t - 2; ++i)
+        rec_cmd += " " + shares[i];
+    if (run_cmd(rec_cmd + " 2>&1").find("k + t - 1") == std::string::npos)
+    {
+        std::cerr << "shamir reconstruct-packed accepted k+t-2 shares\n";
+        return false;
+    }
+    rec_cmd += " " + shares[k + t - 2];
+    std::vector<std::string> rec = split(run_cmd(rec_cmd));
+    if (rec.size() != secrets.size())
+        return false;
+    for (size_t i = 0; i < rec.size(); ++i)
+        if (rec[i].find_first_not_of('0') != rec[i].size() - secrets[i].size() ||
+            rec[i].compare(rec[i].size() - secrets[i].size(), std::string::npos, secrets[i]) != 0)
+            return false;
+    return true;
+}
+
+// 测试二进制份额文件：share --out 写出，reconstruct --in 按文件头的门限读回前t个份额
+bool test_shamir_binary(int t = 50, int n = 2000)
+{
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("shamir");
+    std::vector<std::string> out = split(run_cmd(exe + " share rand " + std::to_string(t) + " " + std::to_string(n) +
+                                                 " --out shamir_binary_test.bin"));
+    std::vector<std::string> rec = split(run_cmd(exe + " reconstruct --in shamir_binary_test.bin"));
+    std::remove("shamir_binary_test.bin");
+    return out.size() == 1 && rec.size() == 1 && out[0] == rec[0];
+}
+
+// 测试纠错重构：n = t + 2e 个份额中篡改 e 个，reconstruct --threshold 应还原秘密并报告被篡改的序号
+bool test_shamir_robust(int t = 5, int e = 3)
+{
+    int n = t + 2 * e;
+    std::string exe = std::string(".") + PATH_SEP + EXE_NAME("shamir");
+    std::vector<std::string> out = split(run_cmd(exe + " share rand " + std::to_string(t) + " " + std::to_string(n)));
+    if (out.size() != (size_t)n + 1)
+    {
+        std::cerr << "shamir share output parse fail\n";
+        return false;
+    }
+
+    std::vector<std::string> shares(out.begin() + 1, out.end());
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937{std::random_device{}()});
+    std::vector<int> bad(order.begin(), order.begin() + e);
+    std::sort(bad.begin(), bad.end());
+    std::string expected = "错误份额:";
+    for (int i : bad)
+    {
+        shares[i] = shares[i].substr(0, shares[i].find(':') + 1) + "1234ABCD"; // 篡改y值
+        expected += " " + std::to_string(i + 1);
+    }
+
+    std::string rec_cmd = exe + " reconstruct --threshold " + std::to_string(t);
+    for (auto &s : shares)
+        rec_cmd += " " + s;
+    std::istringstream iss(run_cmd(rec_cmd));
+    std::string rec_hex, report;
+    std::getline(iss, rec_hex);
+    std::getline(iss, report);
+
+    // 非法门限（非数字、负数、0）报用法错误，不能退回普通重构
+    bool invalid_rejected = true;
+    for (std::string th : {"abc", "-3", "0"})
+    {
+        std::string o = run_cmd(exe + " reconstruct --threshold " + th + " 1:2 2:3 2>&1");
+        if (o.find("门限无效: " + th) == std::string::npos)
+        {
+            std::cerr << "shamir --threshold " << th << " not rejected\n";
+            invalid_rejected = false;
+        }
+    }
+    return rec_hex == out[0] && report == expected && invalid_rejected;
+}
+
 int main()
 {
     bool h = test_hash_commit(); // 运行哈希承诺测试
     bool p = test_pedersen();    // 运行Pedersen承诺测试
+    bool pn = test_pedersen_negative(); // 负数消息
+    bool pt = test_pedersen_tables();   // 预计算表缓存校验
     bool s = test_shamir();      // 运行Shamir秘密分享测试
+    bool sl = test_shamir(200, 256); // 大门限：验证批量求逆重构
+    bool sf = test_shamir_file();    // 按字节的文件分享
+    bool st = test_shamir(300, 1000, " --threads 4"); // 多线程份额生成与重构
+    bool sp = test_shamir_packed();                    // 打包（多秘密）分享
+    bool sb = test_shamir_binary();                    // 二进制份额文件
+    bool sr = test_shamir_robust();                    // 纠错重构
+    bool hb = test_batch("hash_commit");               // 批处理模式
+    bool pb = test_batch("pedersen");
+    bool sbt = test_shamir_batch();
+    bool pv = test_pedersen_verify_batch();            // 随机线性组合批量验证
+    bool pvec = test_pedersen_vector();                // 向量承诺
+    bool pagg = test_pedersen_aggregate();             // 同态聚合
+    bool pcb = test_pedersen_commit_batch();           // 批量创建承诺
+    bool hcb = test_hash_commit_batch();               // 多路 SHA-256 批量承诺
+    bool hm = test_hash_merkle();                      // Merkle 批量承诺
+    bool hf = test_hash_commit_file();                 // 文件承诺
+    bool bj = test_bench_json();                       // 基准程序的JSON输出
 
     // 输出测试结果
     std::cout << "HashCommit test: " << (h ? "PASS" : "FAIL") << "\n"; // 输出哈希承诺测试结果
     std::cout << "Pedersen test: " << (p ? "PASS" : "FAIL") << "\n";   // 输出Pedersen承诺测试结果
+    std::cout << "Pedersen negative message test: " << (pn ? "PASS" : "FAIL") << "\n";
+    std::cout << "Pedersen tables cache test: " << (pt ? "PASS" : "FAIL") << "\n";
     std::cout << "Shamir test: " << (s ? "PASS" : "FAIL") << "\n";     // 输出Shamir秘密分享测试结果
+    std::cout << "Shamir large quorum test: " << (sl ? "PASS" : "FAIL") << "\n";
+    std::cout << "Shamir file test: " << (sf ? "PASS" : "FAIL") << "\n";
+    std::cout << "Shamir threads test: " << (st ? "PASS" : "FAIL") << "\n";
+    std::cout << "Shamir packed test: " << (sp ? "PASS" : "FAIL") << "\n";
+    std::cout << "Shamir binary shares test: " << (sb ? "PASS" : "FAIL") << "\n";
+    std::cout << "Shamir robust reconstruct test: " << (sr ? "PASS" : "FAIL") << "\n";
+    std::cout << "HashCommit batch test: " << (hb ? "PASS" : "FAIL") << "\n";
+    std::cout << "Pedersen batch test: " << (pb ? "PASS" : "FAIL") << "\n";
+    std::cout << "Shamir batch test: " << (sbt ? "PASS" : "FAIL") << "\n";
+    std::cout << "Pedersen verify-batch test: " << (pv ? "PASS" : "FAIL") << "\n";
+    std::cout << "Pedersen vector test: " << (pvec ? "PASS" : "FAIL") << "\n";
+    std::cout << "Pedersen aggregate test: " << (pagg ? "PASS" : "FAIL") << "\n";
+    std::cout << "Pedersen commit-batch test: " << (pcb ? "PASS" : "FAIL") << "\n";
+    std::cout << "HashCommit commit-batch test: " << (hcb ? "PASS" : "FAIL") << "\n";
+    std::cout << "HashCommit Merkle test: " << (hm ? "PASS" : "FAIL") << "\n";
+    std::cout << "HashCommit file test: " << (hf ? "PASS" : "FAIL") << "\n";
+    std::cout << "Bench JSON test: " << (bj ? "PASS" : "FAIL") << "\n";
 
-    if (h && p && s)
+    if (h && p && pn && pt && s && sl && sf && st && sp && sb && sr && hb && pb && sbt && pv && pvec && pagg && pcb && hcb && hm && hf && bj)
         return 0; // 如果所有测试都通过，返回0
     return 1;     // 如果有测试失败，返回1
 }
@@ -0,0 +1,111 @@
+#ifndef _merkle_hpp_
+#define _merkle_hpp_
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "sha256_mb.hpp"
+
+// Merkle 批量承诺：n 个 32 字节叶子（如哈希承诺 SHA256(m_i || r_i)）只公开一个根与 n，
+// 打开第 i 个叶子时附带 O(log n) 个兄弟节点组成的认证路径
+// 内部节点 = SHA256(0x01 || 左 || 右)；某层节点数为奇数时最后一个节点直接提升到上一层（不复制自身），
+// 因此树的形状只由 n 决定，同一个根不会对应两种不同的叶子序列
+
+namespace merkle_detail
+{
+    const unsigned char NODE_PREFIX = 0x01;
+
+    // 每批哈希的节点对数：足够填满多路 SHA-256 的所有通道，输出缓冲区又留在缓存里
+    const size_t CHUNK = 4096;
+
+    inline void hash_node(const unsigned char *left, const unsigned char *right, unsigned char out[32])
+    {
+        unsigned char pair[64];
+        std::memcpy(pair, left, 32);
+        std::memcpy(pair + 32, right, 32);
+        Sha256Msg msg = {&NODE_PREFIX, 1, pair, 64};
+        sha256_batch(&msg, 1, (unsigned char (*)[32])out, Sha256Impl::Scalar);
+    }
+}
+
+// 认证路径的节点数（与 index 有关：奇数层末尾被提升的节点在该层没有兄弟）
+inline size_t merkle_path_length(size_t n, size_t index)
+{
+    size_t len = 0;
+    for (size_t m = n; m > 1; m = (m + 1) / 2, index /= 2)
+        if ((index ^ 1) < m)
+            ++len;
+    return len;
+}
+
+// 由叶子计算 Merkle 根
+// level 为连续存放的 n 个 32 字节叶子，构建时被逐层原地覆盖（内存中始终只有一层），结束时前 32 字节为根
+// 每层的节点对用多路 SHA-256 成批哈希；want 中的叶子下标在构建过程中顺带收集认证路径，
+// paths[k] 为 want[k] 自底向上的兄弟节点（连续的 32 字节块）
+inline void merkle_build(std::vector<unsigned char> &level, const std::vector<size_t> &want,
+                         std::vector<std::vector<unsigned char>> &paths, Sha256Impl impl = Sha256Impl::Auto)
+{
+    using namespace merkle_detail;
+    size_t m = level.size() / 32;
+    if (m == 0 || level.size() % 32 != 0)
+        throw std::invalid_argument("Merkle 树至少需要一个 32 字节的叶子");
+    std::vector<size_t> at(want);
+    for (size_t i : at)
+        if (i >= m)
+            throw std::out_of_range("叶子下标越界: " + std::to_string(i));
+    paths.assign(want.size(), {});
+
+    std::vector<Sha256Msg> msgs(CHUNK);
+    std::vector<unsigned char> out(32 * CHUNK);
+    for (; m > 1; m = (m + 1) / 2)
+    {
+        for (size_t k = 0; k < at.size(); ++k)
+        {
+            size_t sibling = at[k] ^ 1;
+            if (sibling < m)
+                paths[k].insert(paths[k].end(), level.begin() + 32 * sibling, level.begin() + 32 * (sibling + 1));
+            at[k] /= 2;
+        }
+        // 第 a 批的节点对读取 [64a, 64b)，结果写到 [32a, 32b)：只覆盖已经读过的位置
+        size_t pairs = m / 2;
+        for (size_t a = 0; a < pairs; a += CHUNK)
+        {
+            size_t b = std::min(pairs, a + CHUNK);
+            for (size_t j = a; j < b; ++j)
+                msgs[j - a] = {&NODE_PREFIX, 1, level.data() + 64 * j, 64};
+            sha256_batch(msgs.data(), b - a, (unsigned char (*)[32])out.data(), impl);
+            std::memcpy(level.data() + 32 * a, out.data(), 32 * (b - a));
+        }
+        if (m % 2)
+            std::memmove(level.data() + 32 * pairs, level.data() + 32 * (m - 1), 32);
+    }
+    level.resize(32);
+}
+
+// 验证第 index 个叶子（共 n 个）经认证路径 path 得到根 root
+inline bool merkle_verify(const unsigned char root[32], size_t n, size_t index, const unsigned char leaf[32],
+                          const std::vector<unsigned char> &path)
+{
+    if (index >= n || path.size() != 32 * merkle_path_length(n, index))
+        return false;
+    unsigned char node[32];
+    std::memcpy(node, leaf, 32);
+    const unsigned char *sibling = path.data();
+    for (size_t m = n; m > 1; m = (m + 1) / 2, index /= 2)
+    {
+        if ((index ^ 1) >= m)
+            continue; // 被提升的节点
+        if (index & 1)
+            merkle_detail::hash_node(sibling, node, node);
+        else
+            merkle_detail::hash_node(node, sibling, node);
+        sibling += 32;
+    }
+    return std::memcmp(node, root, 32) == 0;
+}
+
+#endif // _merkle_hpp_
@@ -1,171 +1,45 @@
-#include <openssl/ec.h>
-#include <openssl/bn.h>
-#include <openssl/rand.h>
-#include <openssl/evp.h>
-#include <iostream>
-#include <typeinfo>
-#include <sstream>
-#include <iomanip>
-#include <vector>
-#include <stdexcept>
+#include "pedersen.hpp"
 
-// TODO: 学生需要实现此函数 - 将BIGNUM（大整数）转换为十六进制字符串
-std::string bn_to_hex(const BIGNUM *n)
-{
-    // 提示：使用OpenSSL的BN_bn2hex函数将BIGNUM类型大整数转换为十六进制字符串(char*)，然后转换为std::string
-    // 记住使用OPENSSL_free释放BN_bn2hex返回的内存
-    // 你的代码在这里
-    auto res = BN_bn2hex(n);
-    std::string hex_str(res);
-    OPENSSL_free(res);
-    return hex_str; // 临时返回，学生需要替换
-}
-
-// TODO: 学生需要实现此函数 - 将椭圆曲线点（EC_POINT）转换为压缩格式的十六进制字符串
-std::string point_to_hex(const EC_GROUP *group, const EC_POINT *P)
-{
-    // 创建BIGNUM上下文，用于椭圆曲线运算
-    BN_CTX *ctx = BN_CTX_new();
-    // 计算椭圆曲线点的压缩格式字节长度
-    size_t len = EC_POINT_point2oct(group, P, POINT_CONVERSION_COMPRESSED, nullptr, 0, ctx);
-    // 创建缓冲区存储压缩后的点数据
-    std::vector<unsigned char> buf(len);
-    // 将椭圆曲线点转换为压缩格式的字节数组
-    EC_POINT_point2oct(group, P, POINT_CONVERSION_COMPRESSED, buf.data(), buf.size(), ctx);
-    BN_CTX_free(ctx); // 释放上下文
-
-    // 将 buf 字节数组转换为十六进制字符串
-    // 你的代码在这里
-    std::ostringstream oss;
-    oss << std::hex << std::uppercase << std::setfill('0');
-    for (unsigned char byte : buf) {
-            oss << std::setw(2) << (int)(byte & 0xFF);
-    }
-    std::string hex = oss.str();
-    return hex; // 临时返回，学生需要替换
-}
-
-// 将字符串哈希为模群阶的标量值
-BIGNUM *hash_to_bn_mod_order(const std::string &s, const BIGNUM *order)
-{
-    unsigned char digest[EVP_MAX_MD_SIZE];
-    unsigned int dlen = 0; // SHA256哈希值为32字节，后面会被置为32
-
-    EVP_MD_CTX *ctx = EVP_MD_CTX_new();            // 创建哈希上下文
-    EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr); // 初始化哈希计算
-    EVP_DigestUpdate(ctx, s.data(), s.size());     // 更新哈希计算
-    EVP_DigestFinal_ex(ctx, digest, &dlen);        // 完成哈希计算并得到结果
-    EVP_MD_CTX_free(ctx);
-    BIGNUM *bn = BN_new();        // 创建新的大整数
-    BN_bin2bn(digest, dlen, bn);  // 将哈希结果（字节数组）转换为大整数
-    BN_CTX *bctx = BN_CTX_new();  // 创建BIGNUM计算上下文
-    BIGNUM *res = BN_new();       // 创建结果大整数
-    BN_mod(res, bn, order, bctx); // 计算哈希值模群阶的值
-    BN_free(bn);                  // 释放中间大整数
-    BN_CTX_free(bctx);            // 释放BIGNUM上下文
-    return res;                   // 返回模群阶的标量值
-}
-
-// TODO: 学生需要实现此函数 - 执行Pedersen承诺操作
-// 输入：椭圆曲线群、消息m、随机数r、基点G、辅助点H、计算上下文
-// 输出：承诺点C = m*G + r*H
-EC_POINT *pedersen_commit(const EC_GROUP *group, const BIGNUM *m, const BIGNUM *r,
-                          const EC_POINT *G, const EC_POINT *H, BN_CTX *ctx)
-{
-    // 提示：
-    // 1. 创建点可使用EC_POINT_new(group)
-    // 2. 计算常数与点的乘法可使用EC_POINT_mul(group, P, m, G, ctx)
-    // 3. 计算点的加法可使用EC_POINT_add(group, P, Q, R, ctx)
-    // 你的代码在这里
-    auto mG = EC_POINT_new(group);
-    auto rH = EC_POINT_new(group);
-    EC_POINT_mul(group, mG, nullptr, G, m, ctx);
-    EC_POINT_mul(group, rH, nullptr, H, r, ctx);
-    auto C = EC_POINT_new(group);
-    EC_POINT_add(group, C, mG, rH, ctx);
-    EC_POINT_free(mG);
-    EC_POINT_free(rH);  
+using namespace ped;
 
-    // return nullptr; // 临时返回，学生需要替换
-    return C;
-}
-
-// TODO: 学生需要实现此函数 - 执行Pedersen验证操作
-// 输入：椭圆曲线群、承诺点C、消息m、随机数r、基点G、辅助点H、计算上下文
-// 输出：验证结果（true表示匹配，false表示不匹配）
-bool pedersen_verify(const EC_GROUP *group, const EC_POINT *C, const BIGNUM *m, const BIGNUM *r,
-                     const EC_POINT *G, const EC_POINT *H, BN_CTX *ctx)
-{
-    // 提示：
-    // 1. 重新计算承诺值 C' = m*G + r*H
-    // 2. 使用EC_POINT_cmp比较原始承诺点C和重新计算的承诺点C'
-    // 3. 释放分配的内存
-    // 你的代码在这里
-    auto *mG = EC_POINT_new(group);
-    auto *rH = EC_POINT_new(group);
-    EC_POINT_mul(group, mG, nullptr, G, m, ctx);  
-    EC_POINT_mul(group, rH, nullptr, H, r, ctx);  
-    EC_POINT *C_ = EC_POINT_new(group);
-    EC_POINT_add(group, C_, mG, rH, ctx);  // C' = mG + rH
-    int cmp_result = EC_POINT_cmp(group, C, C_, ctx);  
-    if (cmp_result < 0) {
-        std::cout << "At" << __LINE__;
-        throw std::runtime_error("EC_POINT_cmp failed");
-    }
-
-    EC_POINT_free(mG);
-    EC_POINT_free(rH);
-    EC_POINT_free(C_);
-    return cmp_result == 0;
-}
-
-struct PedersenCommitResult
+// 向量承诺基准：长度 16..max_n（每次乘4），对比一次向量承诺与逐字段各做一次 m_i*G + r_i*H 的每元素耗时
+// 逐字段的每元素耗时与长度无关，最多取 4096 个字段测量；生成元派生（每个一次开方）单独计时
+void bench_vector(const struct PedersenParams &params, size_t max_n)
 {
-    BIGNUM *message;
-    BIGNUM *randomness;
-    EC_POINT *commitment;
-};
+    auto ms_since = [](std::chrono::steady_clock::time_point start)
+    { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); };
 
-// 确定承诺消息和随机数，并执行Pedersen承诺操作
-// 输入：椭圆曲线群、基点G、辅助点H、计算上下文、消息字符串（可以是"rand"表示随机生成，或十六进制字符串）
-// 输出：包含消息、随机数和承诺点的结构
-struct PedersenCommitResult create_pedersen_commitment(const EC_GROUP *group, const EC_POINT *G, const EC_POINT *H,
-                                                       BN_CTX *ctx, const BIGNUM *order, const std::string &msg_str)
-{
-    struct PedersenCommitResult result;
-
-    // 1. 根据msg_str参数决定是随机生成消息还是解析十六进制字符串
-    // 2. 生成随机数r
-    // 3. 调用pedersen_commit函数计算承诺值
-
-    // 消息m
-    result.message = BN_new(); // 创建存储消息的大整数
-    if (msg_str == "rand")
-    {                                                                 // 如果参数是"rand"，则生成随机消息
-        std::vector<unsigned char> tmp((BN_num_bits(order) + 7) / 8); // 计算群阶的字节数
-        RAND_bytes(tmp.data(), (int)tmp.size());                      // 生成随机字节
-        BN_bin2bn(tmp.data(), (int)tmp.size(), result.message);       // 将随机字节转换为大整数
-        BN_mod(result.message, result.message, order, ctx);           // 将随机大整数模群阶
-    }
-    else
-    {                                                       // 否则将参数作为十六进制消息值
-        BN_hex2bn(&result.message, msg_str.c_str());        // 将十六进制字符串转换为大整数
-        BN_mod(result.message, result.message, order, ctx); // 将消息大整数模群阶
+    std::cout << std::setw(8) << "n" << std::setw(14) << "gens(ms)" << std::setw(14) << "vector(ms)" << std::setw(14)
+              << "vector(us/e)" << std::setw(14) << "field(us/e)" << std::setw(10) << "speedup" << "\n";
+    for (size_t n = 16; n <= max_n; n *= 4)
+    {
+        std::vector<EcScalar> m(n);
+        for (auto &x : m)
+            x = random_scalar(params);
+        EcScalar r = random_scalar(params);
+
+        auto start = std::chrono::steady_clock::now();
+        pedersen_vector_generators(params, n);
+        double gens = ms_since(start);
+
+        start = std::chrono::steady_clock::now();
+        EcAffine<Curve> C = ec_to_affine(pedersen_vector_commit(params, m, r));
+        double vec = ms_since(start);
+
+        size_t fields = std::min<size_t>(n, 4096);
+        start = std::chrono::steady_clock::now();
+        EcPoint<Curve> sum;
+        for (size_t i = 0; i < fields; ++i)
+            sum = ec_add(sum, params.H_table->mul(r, params.G_table->mul(m[i])));
+        double per_field = ms_since(start) * 1000 / fields;
+        volatile bool keep = sum.is_infinity() || C.infinity; // 保留计算结果，防止被优化掉
+        (void)keep;
+
+        double per_elem = vec * 1000 / n;
+        std::cout << std::setw(8) << n << std::fixed << std::setprecision(3) << std::setw(14) << gens << std::setw(14)
+                  << vec << std::setw(14) << per_elem << std::setw(14) << per_field << std::setw(10)
+                  << std::setprecision(2) << per_field / per_elem << "\n";
     }
-
-    // 生成随机数r
-    // 可使用RAND_bytes生成随机字节，BN_bin2bn将随机字节转换为大整数，BN_mod将随机大整数模群阶
-    // 你的代码在这里
-    result.randomness = BN_new(); 
-    std::vector<unsigned char> tmp((BN_num_bits(order) + 7) / 8); 
-    RAND_bytes(tmp.data(), (int)tmp.size());
-    BN_bin2bn(tmp.data(), (int)tmp.size(), result.randomness);
-    BN_mod(result.randomness, result.randomness, order, ctx);
-    // 使用现有的函数pedersen_commit计算承诺值 C = m*G + r*H
-    // 你的代码在这里
-    result.commitment = pedersen_commit(group, result.message, result.randomness, G, H, ctx);
-
-    return result;
 }
 
 void print_usage()
@@ -173,58 +47,17 @@ void print_usage()
     std::cout << "使用说明:\n"
               << "  pedersen setup-demo        # 显示椭圆曲线参数信息\n"
               << "  pedersen commit <m_hex|'rand'>  # 创建承诺，可以指定消息的十六进制值或使用随机值\n"
-              << "  pedersen verify <C_hex> <m_hex> <r_hex>  # 验证承诺\n";
-}
-
-// TODO: 学生需要实现此函数 - 初始化Pedersen承诺参数
-// 包括椭圆曲线群、群阶、基点G、辅助点H等
-struct PedersenParams
-{
-    EC_GROUP *group;
-    BIGNUM *order;
-    const EC_POINT *G;
-    EC_POINT *H;
-    BN_CTX *ctx;
-};
-
-struct PedersenParams init_pedersen_params()
-{
-    struct PedersenParams params;
-
-    // 椭圆曲线设置
-    int nid = NID_X9_62_prime256v1;                 // 使用prime256v1（secp256r1）椭圆曲线
-    params.group = EC_GROUP_new_by_curve_name(nid); // 创建椭圆曲线群
-    if (!params.group)
-    {
-        std::cerr << "EC_GROUP_new failed\n";
-        params.order = nullptr; // 可用于后续检查
-        return params;
-    }
-    params.ctx = BN_CTX_new();                                  // 创建BIGNUM计算上下文（辅助计算）
-    params.order = BN_new();                                    // 创建存储群阶的大整数
-    EC_GROUP_get_order(params.group, params.order, params.ctx); // 获取椭圆曲线群的阶
-
-    // 生成H = hash_to_point("Pedersen H generator v1") -> scalar*G
-    // 使用哈希函数生成第二个生成元H
-    BIGNUM *h_scalar = hash_to_bn_mod_order("Pedersen H generator v1", params.order); // 计算H的标量
-    params.H = EC_POINT_new(params.group);                                            // 创建H点
-    params.G = EC_GROUP_get0_generator(params.group);                                 // 获取椭圆曲线的基点G
-    // 计算H = h_scalar * G，即标量乘法运算
-    EC_POINT_mul(params.group, params.H, nullptr, params.G, h_scalar, params.ctx);
-
-    // 释放临时变量
-    BN_free(h_scalar);
-
-    return params;
-}
-
-// 释放Pedersen参数占用的内存
-void free_pedersen_params(struct PedersenParams &params)
-{
-    BN_free(params.order);
-    EC_POINT_free(params.H);
-    EC_GROUP_free(params.group);
-    BN_CTX_free(params.ctx);
+              << "  pedersen verify <C_hex> <m_hex> <r_hex>  # 验证承诺\n"
+              << "  pedersen commit-batch <file>  # 文件每行一个消息（十六进制或 rand），批量创建承诺，输出同 commit\n"
+              << "  pedersen verify-batch <file>  # 批量验证文件中每行的 C m r（随机线性组合 + 二分定位无效行）\n"
+              << "  pedersen commit-add <C1_hex> <C2_hex> ...  # 承诺相加，结果是 sum m_i、sum r_i 的承诺\n"
+              << "  pedersen commit-scale <C_hex> <k_hex>  # 承诺数乘，结果是 k*m、k*r 的承诺\n"
+              << "  pedersen aggregate <file>  # 单遍累加文件中每行第一个字段的承诺点，输出 C 与个数\n"
+              << "  pedersen vector-commit <m1_hex> <m2_hex> ...  # 向量承诺 C = sum m_i*G_i + r*H，输出 C r\n"
+              << "  pedersen vector-verify <C_hex> <r_hex> <m1_hex> <m2_hex> ...  # 验证向量承诺\n"
+              << "  pedersen bench-vector [max_n]  # 向量承诺基准，长度 16..max_n（默认65536）\n"
+              << "  pedersen --batch           # 从标准输入逐行读取 commit/verify 命令，参数只初始化一次\n"
+              << "  选项: --tables <file>      # G、H 预计算表的缓存文件，存在则加载，否则建表后写入\n";
 }
 
 /* void __attribute__((constructor)) mian(){
@@ -237,29 +70,18 @@ void free_pedersen_params(struct PedersenParams &params)
 } */
 
 
-int main(int argc, char **argv)
+// 执行一条命令，args[0] 为命令名；参数错误时返回 false，无效输入抛出异常
+bool run_command(const struct PedersenParams &params, const std::vector<std::string> &args)
 {
-    if (argc < 2)
-    {
-        print_usage();
-        return 1;
-    } // 如果参数不足，显示使用说明并退出
-    std::string cmd = argv[1]; // 获取命令参数
-
-    // 初始化Pedersen参数
-    struct PedersenParams params = init_pedersen_params();
-    if (!params.group)
-    {
-        std::cerr << "Failed to initialize Pedersen parameters\n";
-        return 1;
-    }
-
     // 从参数结构体中提取相关变量
     EC_GROUP *group = params.group;
     BIGNUM *order = params.order;
     const EC_POINT *G = params.G;
     EC_POINT *H = params.H;
     BN_CTX *ctx = params.ctx;
+    if (args.empty())
+        return false;
+    const std::string &cmd = args[0];
 
     if (cmd == "setup-demo")
     { // 如果是setup-demo命令
@@ -268,65 +90,164 @@ int main(int argc, char **argv)
         std::cout << "G (压缩十六进制): " << point_to_hex(group, G) << "\n"; // 输出基点G的压缩十六进制表示
         std::cout << "H (压缩十六进制): " << point_to_hex(group, H) << "\n"; // 输出H点的压缩十六进制表示
     }
-    else if (cmd == "commit" && argc == 3)
+    else if (cmd == "commit" && args.size() == 2)
     { // 如果是commit命令且参数数量正确
         // 使用承诺函数生成随机数并计算承诺值
-        struct PedersenCommitResult result = create_pedersen_commitment(group, G, H, ctx, order, std::string(argv[2]));
+        struct PedersenCommitResult result = create_pedersen_commitment(params, args[1]);
 
         // 输出承诺点C的十六进制表示，消息m的十六进制表示，随机数r的十六进制表示
-        std::cout << point_to_hex(group, result.commitment) << " "
-                    << bn_to_hex(result.message) << " " << bn_to_hex(result.randomness) << std::endl;
+        std::cout << point_to_hex(result.commitment) << " "
+                    << bn_to_hex(result.message) << " " << bn_to_hex(result.randomness) << "\n";
 
         // 释放分配的内存
         BN_free(result.message);
         BN_free(result.randomness);
-        EC_POINT_free(result.commitment);
     }
-    else if (cmd == "verify" && argc == 5)
+    else if (cmd == "verify" && args.size() == 4)
     {                                                               // 如果是verify命令且参数数量正确
-        std::string Chex = argv[2], mhex = argv[3], rhex = argv[4]; // 获取承诺点、消息、随机数的十六进制字符串
-        // 解析承诺点C
-        size_t buflen = Chex.size() / 2;        // 计算十六进制字符串对应的字节数
-        std::vector<unsigned char> buf(buflen); // 创建缓冲区
-        // 将十六进制字符串转换为字节数组
-        for (size_t i = 0; i < buflen; i++)
-        {
-            unsigned int v;
-            std::istringstream iss(Chex.substr(2 * i, 2)); // 读取每两个十六进制字符
-            iss >> std::hex >> v;                          // 将十六进制转换为整数
-            buf[i] = (unsigned char)v;                     // 存储为字节
-        }
-        EC_POINT *C = EC_POINT_new(group); // 创建椭圆曲线点C
-        // 将字节数组转换为椭圆曲线上的点
-        if (EC_POINT_oct2point(group, C, buf.data(), buf.size(), ctx) != 1)
-        {
-            std::cerr << "无效的C点\n";
-            return 1; // 如果转换失败，输出错误并退出
-        }
+        std::string Chex = args[1], mhex = args[2], rhex = args[3]; // 获取承诺点、消息、随机数的十六进制字符串
+        // 解析承诺点C的编码（压缩格式不解压，见 pedersen_verify_encoded）
+        std::vector<unsigned char> C;
+        if (!hex_decode(Chex, C))
+            throw std::runtime_error("无效的C点");
         // 解析消息m和随机数r
         BIGNUM *m = BN_new();
         BN_hex2bn(&m, mhex.c_str());
-        BN_mod(m, m, order, ctx); // 将m的十六进制字符串转换为大整数并模群阶
+        BN_nnmod(m, m, order, ctx); // 将m的十六进制字符串转换为大整数并模群阶（负数约化到 [0, 群阶)）
         BIGNUM *r = BN_new();
         BN_hex2bn(&r, rhex.c_str());
-        BN_mod(r, r, order, ctx); // 将r的十六进制字符串转换为大整数并模群阶
+        BN_nnmod(r, r, order, ctx); // 将r的十六进制字符串转换为大整数并模群阶
 
-        // 使用验证函数执行验证
-        bool result = pedersen_verify(group, C, m, r, G, H, ctx);
+        // 使用验证函数执行验证（非压缩编码的C无效时会抛出异常，先释放m、r）
+        bool result;
+        try
+        {
+            result = pedersen_verify_encoded(params, C, m, r);
+        }
+        catch (...)
+        {
+            BN_free(m);
+            BN_free(r);
+            throw;
+        }
         std::cout << (result ? "OK\n" : "FAIL\n");
 
         // 释放分配的内存
         BN_free(m);
         BN_free(r);
-        EC_POINT_free(C);
     }
+    else if (cmd == "verify-batch" && args.size() == 2)
+    { // 批量验证文件中的打开值：第一行 OK/FAIL 与计数，有无效项时第二行列出其行号
+        size_t total = 0;
+        std::vector<size_t> bad = pedersen_verify_batch(params, args[1], total);
+        if (bad.empty())
+            std::cout << "OK " << total << "\n";
+        else
+        {
+            std::cout << "FAIL " << bad.size() << "/" << total << "\n无效的行:";
+            for (size_t l : bad)
+                std::cout << " " << l;
+            std::cout << "\n";
+        }
+    }
+    else if (cmd == "commit-batch" && args.size() == 2)
+        pedersen_commit_batch(params, args[1], std::cout);
+    else if (cmd == "commit-add" && args.size() >= 2)
+    {
+        std::vector<EcAffine<Curve>> Cs;
+        for (size_t i = 1; i < args.size(); ++i)
+            Cs.push_back(point_from_hex(args[i]));
+        std::cout << point_to_hex(pedersen_commit_add(Cs)) << "\n";
+    }
+    else if (cmd == "commit-scale" && args.size() == 3)
+        std::cout << point_to_hex(pedersen_commit_scale(point_from_hex(args[1]), scalar_from_hex(params, args[2]))) << "\n";
+    else if (cmd == "aggregate" && args.size() == 2)
+    {
+        size_t count = 0;
+        EcAffine<Curve> C = pedersen_aggregate_file(args[1], count);
+        std::cout << point_to_hex(C) << " " << count << "\n";
+    }
+    else if (cmd == "vector-commit" && args.size() >= 2)
+    { // 消息向量来自命令行，随机数 r 随机生成
+        std::vector<EcScalar> m;
+        for (size_t i = 1; i < args.size(); ++i)
+            m.push_back(scalar_from_hex(params, args[i]));
+        EcScalar r = random_scalar(params);
+        std::cout << point_to_hex(ec_to_affine(pedersen_vector_commit(params, m, r))) << " " << scalar_to_hex(r) << "\n";
+    }
+    else if (cmd == "vector-verify" && args.size() >= 4)
+    {
+        EcAffine<Curve> C = point_from_hex(args[1]);
+        EcScalar r = scalar_from_hex(params, args[2]);
+        std::vector<EcScalar> m;
+        for (size_t i = 3; i < args.size(); ++i)
+            m.push_back(scalar_from_hex(params, args[i]));
+        std::cout << (pedersen_vector_verify(params, C, m, r) ? "OK\n" : "FAIL\n");
+    }
+    else if (cmd == "bench-vector" && args.size() <= 2)
+        bench_vector(params, args.size() == 2 ? std::stoul(args[1]) : 65536);
     else
+        return false;
+    return true;
+
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
     {
-        print_usage(); // 如果命令不匹配，显示使用说明
+        print_usage();
         return 1;
+    } // 如果参数不足，显示使用说明并退出
+
+    // 全局选项 --tables <file>：预计算表缓存
+    std::string table_path;
+    if (argc >= 3 && std::string(argv[1]) == "--tables")
+    {
+        table_path = argv[2];
+        argv += 2;
+        argc -= 2;
+        if (argc < 2)
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    // 初始化Pedersen参数（含预计算表）
+    struct PedersenParams params = init_pedersen_params(table_path);
+    if (!params.group)
+    {
+        std::cerr << "Failed to initialize Pedersen parameters\n";
+        return 1;
+    }
+
+    int status = 0;
+    if (argc == 2 && std::string(argv[1]) == "--batch")
+    { // 整个批次共用同一组参数（群、H、BN_CTX）
+        status = run_batch([&](const std::string &line)
+                           {
+            std::vector<std::string> args = split_fields(line);
+            return run_command(params, args); });
+    }
+    else
+    {
+        try
+        {
+            if (!run_command(params, std::vector<std::string>(argv + 1, argv + argc)))
+            {
+                print_usage(); // 如果命令不匹配，显示使用说明
+                status = 1;
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << e.what() << "\n";
+            status = 1;
+        }
     }
 
     // 释放所有分配的内存
     free_pedersen_params(params);
-    return 0;
-}
\ No newline at end of file
+    return status;
+}
@@ -1,235 +1,123 @@
-#include <openssl/bn.h>   // OpenSSL大整数运算库
-#include <openssl/rand.h> // OpenSSL随机数生成库
-#include <iostream>
-#include <vector>
-#include <string>
-#include <sstream>
-#include <stdexcept>
+#include "shamir.hpp"
 
-// 将BIGNUM（大整数）转换为十六进制字符串
-std::string bn_to_hex(const BIGNUM *n)
-{
-    char *s = BN_bn2hex(n); // 使用OpenSSL函数将大整数转换为十六进制字符串
-    std::string r(s);
-    OPENSSL_free(s); // 释放OpenSSL分配的内存
-    return r;
-}
-
-// 将十六进制字符串转换为BIGNUM（大整数）
-BIGNUM *hex_to_bn(const std::string &hex)
-{
-    BIGNUM *n = nullptr;
-    BN_hex2bn(&n, hex.c_str()); // 使用OpenSSL函数将十六进制字符串转换为大整数
-    return n;
-}
-
-// 生成模mod的随机数
-BIGNUM *rand_mod(const BIGNUM *mod)
-{
-    int nbytes = (BN_num_bits(mod) + 7) / 8;           // 计算模数的字节数，向上取整
-    std::vector<unsigned char> buf(nbytes);            // 创建随机字节缓冲区
-    if (RAND_bytes(buf.data(), nbytes) != 1)           // 使用OpenSSL的随机数生成器
-        throw std::runtime_error("RAND_bytes failed"); // 如果随机数生成失败，抛出异常
-    BIGNUM *bn = BN_bin2bn(buf.data(), nbytes, nullptr);                 // 将字节数组转换为大整数
-    BN_CTX *ctx = BN_CTX_new();                        // 创建BIGNUM计算上下文
-    BIGNUM *res = BN_new();                            // 创建结果大整数
-    BN_mod(res, bn, mod, ctx);               // 计算bn mod mod，即对模数取模
-    BN_free(bn);                                       // 释放临时大整数
-    BN_CTX_free(ctx);                                  // 释放计算上下文
-    return res;                                        // 返回模mod的随机数
-}
-
-// 计算模逆元：找到a关于mod的乘法逆元
-BIGNUM *modinv(const BIGNUM *a, const BIGNUM *mod)
-{
-    BN_CTX *ctx = BN_CTX_new();                                   // 创建计算上下文
-    BIGNUM *inv = BN_mod_inverse(nullptr, a, mod, ctx); // 使用OpenSSL函数计算模逆元
-    BN_CTX_free(ctx);                                             // 释放计算上下文
-    if (!inv)
-        throw std::runtime_error("没有逆元"); // 如果不存在逆元，抛出异常
-    return inv;                               // 返回模逆元
-}
-
-// TODO: 学生需要实现此函数 - 在x点计算多项式的值
-BIGNUM *eval_poly(const std::vector<BIGNUM *> &coeffs, const BIGNUM *x, const BIGNUM *mod)
-{
-    // 提示：
-    // 计算 f(x) = coeffs[0] + coeffs[1]*x + coeffs[2]*x^2 + ...
-    // 你的代码 在这里
-
-    // std::cout << "Call " << __FUNCTION__ << "\n";
-    auto res = BN_new(); // init
-    BN_zero(res);
-
-    auto len = coeffs.size();
-    auto CTX = BN_CTX_new();
-
-    // 霍纳法则
-    for (int i = len - 1; i >= 0; --i) { // 高位到低位
-        BN_mod_mul(res, res, x, mod, CTX); // res * x
-        BN_mod_add(res, res, coeffs[i], mod, CTX); // res + coeffs[i]
-    }
-
-    BN_CTX_free(CTX);
-    return res;
-    // return nullptr; // 临时返回，学生需要替换
-}
-
-// TODO: 学生需要实现此函数 - 使用拉格朗日插值法重构秘密
-BIGNUM *lagrange_reconstruct_at_zero(const std::vector<std::pair<BIGNUM *, BIGNUM *>> &points, const BIGNUM *mod)
-{
-    // 提示：
-    // 1. 对于每个点i，计算拉格朗日基函数li(0) = product_{j!=i}(0-xj)/(xi-xj)
-    // 2. 重构值 = sum(yi * li(0))
-    // 3. 所有运算都要在模mod下进行
-    // 你的代码在这里
-    auto len = points.size();
-
-    BIGNUM *result = BN_new();
-    BN_zero(result);
-    BN_CTX *ctx = BN_CTX_new();
-
-    auto ZERO = BN_new();
-    BN_zero(ZERO);
-
-    for (int i = 0; i < len; ++i) {
-        BIGNUM *li = BN_new();
-        BN_one(li); // 初始化为1
-
-        // x - x_j / x_i - x_j
-        // len 个点计算 len - 1 个分式
-        for (int j = 0; j < len; ++j) { // len
-            if (j == i) continue; // len - 1
-
-            // -x_j mod mod
-            BIGNUM *_xj = BN_new();
-            BN_mod_sub(_xj, ZERO, points[j].first, mod, ctx);
-
-            // xi - xj mod mod
-            BIGNUM *xi_m_xj = BN_new();
-            BN_mod_sub(xi_m_xj, points[i].first, points[j].first, mod, ctx);
-
-            //  1 / (xi - xj) mod mod
-            BIGNUM *_xi_m_xj = modinv(xi_m_xj, mod);
-
-            // -xj / xi-xj mod mod
-            BIGNUM *final = BN_new();
-            BN_mod_mul(final, _xj, _xi_m_xj, mod, ctx);
-
-            // li *= final mod mod
-            BN_mod_mul(li, li, final, mod, ctx);
-
-            BN_free(_xj);
-            BN_free(xi_m_xj);
-            BN_free(_xi_m_xj);
-            BN_free(final);
-        }
-
-        // yi * li mod mod
-        BIGNUM *contrib = BN_new();
-        BN_mod_mul(contrib, points[i].second, li, mod, ctx);
-
-        // result += contrib mod mod
-        BN_mod_add(result, result, contrib, mod, ctx);
+using namespace sh;
 
-        BN_free(li);
-        BN_free(contrib);
-    }
-    
-    return result;
-    return nullptr; // 临时返回，学生需要替换
-}
-
-// 确定秘密和多项式系数
-// 根据输入参数决定是随机生成秘密还是从十六进制字符串解析秘密，然后生成多项式的系数
-std::pair<BIGNUM *, std::vector<BIGNUM *>> generate_secret_and_coeffs(BIGNUM *prime, const std::string &secret_arg, int t)
-{
-    // 如果参数是"rand"，则随机生成秘密；否则从十六进制字符串解析秘密
-    BN_CTX *ctx = BN_CTX_new(); // 创建BIGNUM计算上下文
-    BIGNUM *temp_secret = (secret_arg == "rand") ? rand_mod(prime) : hex_to_bn(secret_arg);
-    BIGNUM *secret = BN_new();
-    BN_mod(secret, temp_secret, prime, ctx);
-    BN_free(temp_secret); // 释放临时秘密
-    std::vector<BIGNUM *> coeffs;     // 存储多项式系数的向量
-    coeffs.push_back(BN_dup(secret)); // 常数项是秘密值
-    for (int i = 1; i < t; i++)
-        coeffs.push_back(rand_mod(prime)); // 生成t-1个随机系数
-    return {secret, coeffs};               // 返回秘密和系数向量的配对
-}
-
-// TODO: 学生需要实现此函数 - 根据系数生成份额
-std::vector<std::pair<int, BIGNUM *>> generate_shares(BIGNUM *prime, const std::vector<BIGNUM *> &coeffs, int n)
-{
-    // 提示：
-    // 1. 创建存储份额的向量，每个份额是(序号, y值)的配对
-    // 2. 对于每个i从1到n，计算x=i, y=f(i)
-    // 3. 使用eval_poly计算多项式值
-    // 你的代码在这里
-    // std::cout << "Call " << __FUNCTION__ << "\n";
-    std::vector<std::pair<int, BIGNUM *>> shares;
-
-    auto len = coeffs.size();
-    try {
-
-        for (int i = 1; i <= n; ++i) {
-            auto x = BN_new();
-            BN_set_word(x, i);
-
-            auto y = eval_poly(coeffs, x, prime);
-            shares.push_back({i, y});
-
-            BN_free(x); 
-        }
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-    }
-
-    return shares;
-
-    return {}; // 临时返回，学生需要替换
-}
-
-// 重构秘密
-// 使用拉格朗日插值法从给定的份额重构原始秘密
-BIGNUM *reconstruct_secret(BIGNUM *prime, const std::vector<std::pair<int, BIGNUM *>> &shares)
+// 多点求值基准：对比逐点霍纳与有限差分在不同 (t, n) 下每个份额的耗时，并给出交叉点
+// 分别测试定长域（secp256k1 p）与通用BIGNUM路径（P-256 素数）
+void bench_eval()
 {
-    // 将整数x坐标转换为BIGNUM格式，以便用于拉格朗日插值
-    std::vector<std::pair<BIGNUM *, BIGNUM *>> pts; // 存储点(x,y)的向量
-    for (auto &p : shares)
-    { // 遍历每个份额
-        BIGNUM *xi = BN_new();
-        BN_set_word(xi, p.first);              // 将整数x坐标转换为BIGNUM
-        pts.push_back({xi, BN_dup(p.second)}); // 将点(x,y)添加到向量中
-    }
-    BIGNUM *secret = lagrange_reconstruct_at_zero(pts, prime); // 使用拉格朗日插值重构秘密
-    // 释放临时点
-    for (auto &pt : pts)
+    const char *fields[2][2] = {{"Fp256 (secp256k1 p)", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F"},
+                                {"BIGNUM (P-256 p)", "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF"}};
+    auto time_us = [](BIGNUM *prime, const std::vector<BIGNUM *> &coeffs, int n, EvalStrategy s)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto shares = generate_shares(prime, coeffs, n, s);
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        for (auto &sh : shares)
+            BN_free(sh.second);
+        return us / n;
+    };
+
+    for (auto &field : fields)
     {
-        BN_free(pt.first);
-        BN_free(pt.second);
+        BIGNUM *prime = hex_to_bn(field[1]);
+        int n_max = Fp256<Secp256k1P>::matches(prime) ? 16384 : 4096;
+        std::cout << "== " << field[0] << "\n"
+                  << std::setw(6) << "t" << std::setw(8) << "n" << std::setw(14) << "horner(us)" << std::setw(14) << "fd(us)"
+                  << std::setw(10) << "auto" << "\n";
+        for (int t = 2; t <= 256; t *= 2)
+        {
+            auto [secret, coeffs] = generate_secret_and_coeffs(prime, "rand", t);
+            int crossover = -1;
+            for (int n = 1; n <= n_max; n *= 2)
+            {
+                double h = time_us(prime, coeffs, n, EvalStrategy::Horner);
+                double d = time_us(prime, coeffs, n, EvalStrategy::FiniteDifference);
+                if (crossover < 0 && d < h)
+                    crossover = n;
+                bool fd = choose_eval_strategy(t, n, Fp256<Secp256k1P>::matches(prime)) == EvalStrategy::FiniteDifference;
+                std::cout << std::setw(6) << t << std::setw(8) << n << std::fixed << std::setprecision(3)
+                          << std::setw(14) << h << std::setw(14) << d << std::setw(10) << (fd ? "fd" : "horner") << "\n";
+            }
+            std::cout << "  t=" << t << " 交叉点: n >= " << crossover << " 时有限差分更快\n";
+            BN_free(secret);
+            for (auto c : coeffs)
+                BN_free(c);
+        }
+        BN_free(prime);
     }
-    return secret; // 返回重构的秘密
 }
 
 void print_usage()
 {
     std::cerr << "用法:\n"
               << "  shamir share <secret_hex|'rand'> <t> <n>\n" // 生成份额模式
-              << "  shamir reconstruct <share1> <share2> ...\n"; // 重构秘密模式
+              << "  shamir reconstruct <share1> <share2> ...\n" // 重构秘密模式
+              << "  shamir share-packed <secrets_file> <t> <n>\n"          // 打包分享：文件中每行一个十六进制秘密
+              << "  shamir reconstruct-packed <k> <t> <share1> <share2> ...\n" // 由至少 k+t-1 个份额重构 k 个秘密
+              << "  shamir share-file <in_path> <t> <n> <out_prefix>\n"             // GF(2^8)按字节分享文件，n <= 255
+              << "  shamir reconstruct-file <out_path> <share_file1> <share_file2> ...\n" // 从份额文件重构
+              << "  shamir bench-eval\n"                                                      // 多点求值策略基准
+              << "  shamir --batch\n"                                                         // 从标准输入逐行读取上述命令（不含程序名），每条命令的输出以空行结束
+              << "选项:\n"
+              << "  --threads <N>  份额生成与重构使用的线程数（默认1，0表示全部CPU核心），输出与单线程完全一致\n"
+              << "  --out <file>   share/share-packed 把份额写入二进制份额文件，不再逐行输出\n"
+              << "  --in <file>    reconstruct/reconstruct-packed 从二进制份额文件读取份额（按文件头的门限只读前t个）\n"
+              << "  --threshold <t> reconstruct 按门限t纠错重构：n >= t+2e 个份额中至多e个错误，第二行报告错误份额序号\n";
 }
 
-int main(int argc, char *argv[])
+// 执行一条命令（argv[0] 为程序名，格式与命令行相同），prime 由调用者持有；成功返回0
+int run_command(int argc, char *argv[], BIGNUM *prime)
 {
+    // 先取出全局选项 --threads N / --out 文件 / --in 文件 / --threshold t，其余参数原样左移，各模式按原来的位置解析
+    std::string out_path, in_path; // 二进制份额文件
+    int threshold = 0;             // reconstruct 的门限，给出时启用纠错重构
+    int kept = 1;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string opt(argv[i]);
+        if (opt == "--threads" || opt == "--out" || opt == "--in" || opt == "--threshold")
+        {
+            if (i + 1 >= argc)
+            {
+                print_usage();
+                return 1;
+            }
+            std::string value(argv[++i]);
+            if (opt == "--threads")
+            { // 线程数须为非负十进制整数
+                if (value.empty() || value.size() > 6 || value.find_first_not_of("0123456789") != std::string::npos)
+                {
+                    std::cerr << "线程数无效: " << value << "\n";
+                    print_usage();
+                    return 1;
+                }
+                set_parallel_threads(std::stoul(value));
+            }
+            else if (opt == "--threshold")
+            { // 门限须为正的十进制整数
+                if (value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos ||
+                    (threshold = std::stoi(value)) <= 0)
+                {
+                    std::cerr << "门限无效: " << value << "\n";
+                    print_usage();
+                    return 1;
+                }
+            }
+            else
+                (opt == "--out" ? out_path : in_path) = value;
+            continue;
+        }
+        argv[kept++] = argv[i];
+    }
+    argc = kept;
+
     if (argc < 2)
     { // 检查参数数量
         print_usage();
         return 1;
     }
 
-    // 使用椭圆曲线secp256k1的素数域
-    const char *P_HEX = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F";
-    BIGNUM *prime = hex_to_bn(P_HEX); // 将十六进制素数转换为BIGNUM
-
     std::string mode = argv[1]; // 获取操作模式
     if (mode == "share")
     { // 生成份额模式
@@ -243,10 +131,29 @@ int main(int argc, char *argv[])
         auto [secret, coeffs] = generate_secret_and_coeffs(prime, argv[2], t); // 生成秘密和多项式系数
         std::cout << bn_to_hex(secret) << "\n";                                // 输出原始秘密值（十六进制）
         auto shares = generate_shares(prime, coeffs, n);                       // 生成n个份额
+        if (!out_path.empty())
+        { // 写入二进制份额文件
+            try
+            {
+                ShareWriter writer(out_path, prime, t);
+                writer.write(shares);
+                writer.close();
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "错误: " << e.what() << "\n";
+                free_shares(shares);
+                BN_free(secret);
+                for (auto c : coeffs)
+                    BN_free(c);
+                return 1;
+            }
+        }
         for (auto &s : shares)
-        {                                                               // 输出每个份额
-            std::cout << s.first << ":" << bn_to_hex(s.second) << "\n"; // 格式：序号:y值（十六进制）
-            BN_free(s.second);                                          // 释放份额的y值
+        { // 输出每个份额
+            if (out_path.empty())
+                std::cout << s.first << ":" << bn_to_hex(s.second) << "\n"; // 格式：序号:y值（十六进制）
+            BN_free(s.second);                                              // 释放份额的y值
         }
         BN_free(secret); // 释放秘密值
         for (auto c : coeffs)
@@ -254,30 +161,190 @@ int main(int argc, char *argv[])
     }
     else if (mode == "reconstruct")
     { // 重构秘密模式
-        if (argc < 3)
+        if (argc < 3 && in_path.empty())
         {
             std::cerr << "reconstruct模式参数错误\n";
             return 1;
         }
         std::vector<std::pair<int, BIGNUM *>> shares; // 存储解析的份额
-        for (int i = 2; i < argc; i++)
-        {                           // 解析每个份额参数
-            std::string s(argv[i]); // 获取份额参数，格式为 "x:yhex"
-            auto pos = s.find(':'); // 查找分隔符 ':'
-            if (pos == std::string::npos)
+        try
+        {
+            if (!in_path.empty())
+            { // 从二进制份额文件读取；纠错重构需要文件中的全部份额
+                if (threshold > 0)
+                {
+                    ShareReader reader(in_path);
+                    if (BN_cmp(reader.modulus(), prime) != 0)
+                        throw std::runtime_error("份额文件的域与当前模数不一致: " + in_path);
+                    shares = reader.read();
+                }
+                else
+                    shares = read_share_file(in_path, prime);
+            }
+            for (int i = 2; i < argc; i++)
+                shares.push_back(parse_share_arg(argv[i])); // 解析每个份额参数，格式为 "x:yhex"
+            if (threshold > 0)
+            { // 给出门限时做纠错重构，多出的份额用于检测并纠正错误
+                std::vector<int> bad;
+                BIGNUM *secret = reconstruct_secret_robust(prime, shares, threshold, bad);
+                std::cout << bn_to_hex(secret) << "\n";
+                if (!bad.empty())
+                { // 第二行报告错误份额的序号
+                    std::cout << "错误份额:";
+                    for (int x : bad)
+                        std::cout << " " << x;
+                    std::cout << "\n";
+                }
+                BN_free(secret);
+            }
+            else
+            {
+                BIGNUM *secret = reconstruct_secret(prime, shares); // 使用拉格朗日插值重构秘密
+                std::cout << bn_to_hex(secret) << "\n";             // 输出重构的秘密值（十六进制）
+                BN_free(secret);                                    // 释放重构的秘密值
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "错误: " << e.what() << "\n";
+            free_shares(shares);
+            return 1;
+        }
+        free_shares(shares); // 释放份额的y值
+    }
+    else if (mode == "share-packed")
+    { // 打包（多秘密）分享模式
+        if (argc != 5)
+        {
+            std::cerr << "share-packed模式参数错误\n";
+            return 1;
+        }
+        std::ifstream in(argv[2]);
+        if (!in)
+        {
+            std::cerr << "无法打开秘密文件\n";
+            return 1;
+        }
+        BN_CTX *ctx = BN_CTX_new();
+        std::vector<BIGNUM *> secrets;
+        auto free_secrets = [&]
+        {
+            for (auto s : secrets)
+                BN_clear_free(s);
+        };
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty())
+                continue;
+            BIGNUM *s = hex_to_bn(line);
+            if (!s)
             {
-                std::cerr << "份额格式错误\n";
+                std::cerr << "秘密格式错误: " << line << "\n";
+                BN_CTX_free(ctx);
+                free_secrets();
                 return 1;
-            } // 检查格式
-            int xi = std::stoi(s.substr(0, pos));      // 解析x坐标
-            BIGNUM *yi = hex_to_bn(s.substr(pos + 1)); // 解析y坐标（十六进制）
-            shares.push_back({xi, yi});                // 将份额添加到向量中
+            }
+            BN_nnmod(s, s, prime, ctx); // 与share模式一样约化到域内
+            secrets.push_back(s);
+        }
+        BN_CTX_free(ctx);
+        std::vector<std::pair<int, BIGNUM *>> shares;
+        try
+        {
+            int t = std::stoi(argv[3]);
+            shares = generate_packed_shares(prime, secrets, t, std::stoi(argv[4]));
+            std::cout << secrets.size() << "\n"; // 第一行输出秘密个数k，重构时需要
+            if (!out_path.empty())
+            { // 文件头的门限记为重构所需的份额数 k+t-1
+                ShareWriter writer(out_path, prime, secrets.size() + t - 1);
+                writer.write(shares);
+                writer.close();
+            }
+            if (out_path.empty())
+            {
+                for (auto &s : shares)
+                    std::cout << s.first << ":" << bn_to_hex(s.second) << "\n";
+            }
+            free_shares(shares);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "错误: " << e.what() << "\n";
+            free_shares(shares);
+            free_secrets();
+            return 1;
+        }
+        free_secrets();
+    }
+    else if (mode == "reconstruct-packed")
+    { // 打包重构模式
+        if (argc < 4 || (argc < 5 && in_path.empty()))
+        {
+            std::cerr << "reconstruct-packed模式参数错误\n";
+            return 1;
+        }
+        std::vector<std::pair<int, BIGNUM *>> shares;
+        try
+        {
+            if (!in_path.empty())
+                shares = read_share_file(in_path, prime);
+            for (int i = 4; i < argc; i++)
+                shares.push_back(parse_share_arg(argv[i]));
+            for (auto secret : reconstruct_packed_secrets(prime, shares, std::stoi(argv[2]), std::stoi(argv[3])))
+            {
+                std::cout << bn_to_hex(secret) << "\n"; // 每行一个秘密，顺序与分享时一致
+                BN_free(secret);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "错误: " << e.what() << "\n";
+            free_shares(shares);
+            return 1;
+        }
+        free_shares(shares);
+    }
+    else if (mode == "share-file")
+    { // 按字节分享文件模式
+        if (argc != 6)
+        {
+            std::cerr << "share-file模式参数错误\n";
+            return 1;
+        }
+        try
+        {
+            for (auto &path : share_file(argv[2], std::stoi(argv[3]), std::stoi(argv[4]), argv[5]))
+                std::cout << path << "\n"; // 输出生成的份额文件路径
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "错误: " << e.what() << "\n";
+            return 1;
+        }
+    }
+    else if (mode == "reconstruct-file")
+    { // 从份额文件重构模式
+        if (argc < 4)
+        {
+            std::cerr << "reconstruct-file模式参数错误\n";
+            return 1;
+        }
+        try
+        {
+            reconstruct_file(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "错误: " << e.what() << "\n";
+            return 1;
         }
-        BIGNUM *secret = reconstruct_secret(prime, shares); // 使用拉格朗日插值重构秘密
-        std::cout << bn_to_hex(secret) << "\n";             // 输出重构的秘密值（十六进制）
-        BN_free(secret);                                    // 释放重构的秘密值
-        for (auto &s : shares)
-            BN_free(s.second); // 释放份额的y值
+    }
+    else if (mode == "bench-eval")
+    { // 多点求值基准
+        bench_eval();
     }
     else
     {
@@ -285,6 +352,31 @@ int main(int argc, char *argv[])
         return 1;
     } // 未知模式，输出错误信息
 
-    BN_free(prime); // 释放素数
     return 0;
 }
+
+int main(int argc, char *argv[])
+{
+    // 使用椭圆曲线secp256k1的素数域
+    const char *P_HEX = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F";
+    BIGNUM *prime = hex_to_bn(P_HEX); // 将十六进制素数转换为BIGNUM
+
+    int status;
+    if (argc == 2 && std::string(argv[1]) == "--batch")
+    { // 每行一条命令；素数与按份额持有者缓存的拉格朗日系数在整个批次中复用，每条命令的输出以空行结束
+        status = run_batch([&](const std::string &line)
+                           {
+            std::vector<std::string> args = split_fields(line);
+            args.insert(args.begin(), "shamir");
+            std::vector<char *> cargs;
+            for (auto &a : args)
+                cargs.push_back(&a[0]);
+            return run_command((int)cargs.size(), cargs.data(), prime) == 0; },
+                           true);
+    }
+    else
+        status = run_command(argc, argv, prime);
+
+    BN_free(prime); // 释放素数
+    return status;
+}
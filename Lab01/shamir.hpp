@@ -0,0 +1,548 @@
+#ifndef _shamir_hpp_
+#define _shamir_hpp_
+
+#include <openssl/bn.h>   // OpenSSL大整数运算库
+#include <openssl/rand.h> // OpenSSL随机数生成库
+#include <openssl/crypto.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <chrono>
+#include <iomanip>
+
+#include "lagrange.hpp"
+#include "gf256.hpp"
+#include "thread_pool.hpp"
+#include "share_io.hpp"
+#include "fp_poly.hpp"
+#include "batch.hpp"
+
+// Shamir 秘密分享方案：份额生成与重构、纠错重构、打包分享与按字节的文件分享
+// 命令行程序（shamir.cpp）与 lab01_bench 共用；命名空间 sh 避免与另外两个方案的同名工具函数冲突
+namespace sh
+{
+// 将BIGNUM（大整数）转换为十六进制字符串
+inline std::string bn_to_hex(const BIGNUM *n)
+{
+    char *s = BN_bn2hex(n); // 使用OpenSSL函数将大整数转换为十六进制字符串
+    std::string r(s);
+    OPENSSL_free(s); // 释放OpenSSL分配的内存
+    return r;
+}
+
+// 将十六进制字符串转换为BIGNUM（大整数）
+inline BIGNUM *hex_to_bn(const std::string &hex)
+{
+    BIGNUM *n = nullptr;
+    BN_hex2bn(&n, hex.c_str()); // 使用OpenSSL函数将十六进制字符串转换为大整数
+    return n;
+}
+
+// 解析命令行上的份额 "x:yhex"，格式错误时抛出异常；返回的y值由调用者释放
+inline std::pair<int, BIGNUM *> parse_share_arg(const std::string &s)
+{
+    auto pos = s.find(':');
+    std::string x = pos == std::string::npos ? "" : s.substr(0, pos), y = pos == std::string::npos ? "" : s.substr(pos + 1);
+    if (x.empty() || x.size() > 9 || x.find_first_not_of("0123456789") != std::string::npos ||
+        y.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)
+        throw std::runtime_error("份额格式错误: " + s);
+    BIGNUM *yi = hex_to_bn(y);
+    if (!yi) // 空串或分配失败
+        throw std::runtime_error("份额格式错误: " + s);
+    return {std::stoi(x), yi};
+}
+
+// 释放份额的y值并清空
+inline void free_shares(std::vector<std::pair<int, BIGNUM *>> &shares)
+{
+    for (auto &s : shares)
+        BN_free(s.second);
+    shares.clear();
+}
+
+// 生成模mod的随机数
+inline BIGNUM *rand_mod(const BIGNUM *mod)
+{
+    int nbytes = (BN_num_bits(mod) + 7) / 8;           // 计算模数的字节数，向上取整
+    std::vector<unsigned char> buf(nbytes);            // 创建随机字节缓冲区
+    if (RAND_bytes(buf.data(), nbytes) != 1)           // 使用OpenSSL的随机数生成器
+        throw std::runtime_error("RAND_bytes failed"); // 如果随机数生成失败，抛出异常
+    BIGNUM *bn = BN_bin2bn(buf.data(), nbytes, nullptr);                 // 将字节数组转换为大整数
+    BN_CTX *ctx = BN_CTX_new();                        // 创建BIGNUM计算上下文
+    BIGNUM *res = BN_new();                            // 创建结果大整数
+    BN_mod(res, bn, mod, ctx);               // 计算bn mod mod，即对模数取模
+    BN_free(bn);                                       // 释放临时大整数
+    BN_CTX_free(ctx);                                  // 释放计算上下文
+    return res;                                        // 返回模mod的随机数
+}
+
+// 计算模逆元：找到a关于mod的乘法逆元
+inline BIGNUM *modinv(const BIGNUM *a, const BIGNUM *mod)
+{
+    BN_CTX *ctx = BN_CTX_new();                                   // 创建计算上下文
+    BIGNUM *inv = BN_mod_inverse(nullptr, a, mod, ctx); // 使用OpenSSL函数计算模逆元
+    BN_CTX_free(ctx);                                             // 释放计算上下文
+    if (!inv)
+        throw std::runtime_error("没有逆元"); // 如果不存在逆元，抛出异常
+    return inv;                               // 返回模逆元
+}
+
+// TODO: 学生需要实现此函数 - 在x点计算多项式的值
+inline BIGNUM *eval_poly(const std::vector<BIGNUM *> &coeffs, const BIGNUM *x, const BIGNUM *mod)
+{
+    // 提示：
+    // 计算 f(x) = coeffs[0] + coeffs[1]*x + coeffs[2]*x^2 + ...
+    // 你的代码 在这里
+
+    // std::cout << "Call " << __FUNCTION__ << "\n";
+    // secp256k1 的 p / n 走定长Montgomery域，循环内没有堆分配
+    BIGNUM *fixed = nullptr;
+    if (with_fixed_field(mod, [&](auto field)
+                         {
+        using F = decltype(field);
+        F fx = F::from_bn(x), acc;
+        for (size_t i = coeffs.size(); i-- > 0;)
+            acc = acc * fx + F::from_bn(coeffs[i]);
+        fixed = acc.to_bn(); }))
+        return fixed;
+
+    auto res = BN_new(); // init
+    BN_zero(res);
+
+    auto len = coeffs.size();
+    auto CTX = BN_CTX_new();
+
+    // 霍纳法则
+    for (int i = len - 1; i >= 0; --i) { // 高位到低位
+        BN_mod_mul(res, res, x, mod, CTX); // res * x
+        BN_mod_add(res, res, coeffs[i], mod, CTX); // res + coeffs[i]
+    }
+
+    BN_CTX_free(CTX);
+    return res;
+    // return nullptr; // 临时返回，学生需要替换
+}
+
+// TODO: 学生需要实现此函数 - 使用拉格朗日插值法重构秘密
+inline BIGNUM *lagrange_reconstruct_at_zero(const std::vector<std::pair<BIGNUM *, BIGNUM *>> &points, const BIGNUM *mod)
+{
+    // 提示：
+    // 1. 对于每个点i，计算拉格朗日基函数li(0) = product_{j!=i}(0-xj)/(xi-xj)
+    // 2. 重构值 = sum(yi * li(0))
+    // 3. 所有运算都要在模mod下进行
+    // 你的代码在这里
+    // 使用批量求逆的重构引擎：全部基函数只需一次模逆，临时变量预分配复用
+    LagrangeEngine engine(mod);
+    return engine.reconstruct(points);
+}
+
+// 确定秘密和多项式系数
+// 根据输入参数决定是随机生成秘密还是从十六进制字符串解析秘密，然后生成多项式的系数
+inline std::pair<BIGNUM *, std::vector<BIGNUM *>> generate_secret_and_coeffs(BIGNUM *prime, const std::string &secret_arg, int t)
+{
+    // 如果参数是"rand"，则随机生成秘密；否则从十六进制字符串解析秘密
+    BN_CTX *ctx = BN_CTX_new(); // 创建BIGNUM计算上下文
+    BIGNUM *temp_secret = (secret_arg == "rand") ? rand_mod(prime) : hex_to_bn(secret_arg);
+    BIGNUM *secret = BN_new();
+    BN_mod(secret, temp_secret, prime, ctx);
+    BN_free(temp_secret); // 释放临时秘密
+    std::vector<BIGNUM *> coeffs;     // 存储多项式系数的向量
+    coeffs.push_back(BN_dup(secret)); // 常数项是秘密值
+    for (int i = 1; i < t; i++)
+        coeffs.push_back(rand_mod(prime)); // 生成t-1个随机系数
+    return {secret, coeffs};               // 返回秘密和系数向量的配对
+}
+
+// 多点求值策略：逐点霍纳需要 n*t 次模乘；
+// 有限差分先用 t 次霍纳求出 f(1..t)（t*t 次模乘），之后每个点只需 t-1 次模加
+enum class EvalStrategy
+{
+    Auto,
+    Horner,
+    FiniteDifference
+};
+
+// n >= ratio * t 时自动选择有限差分，交叉点由 shamir bench-eval 测得：
+// 定长域约 2t；通用BIGNUM路径的模加相对模乘没那么便宜，约 4t
+const size_t EVAL_FD_MIN_RATIO_FIXED = 2;
+const size_t EVAL_FD_MIN_RATIO_BN = 4;
+
+inline EvalStrategy choose_eval_strategy(size_t t, size_t n, bool fixed_field)
+{
+    size_t ratio = fixed_field ? EVAL_FD_MIN_RATIO_FIXED : EVAL_FD_MIN_RATIO_BN;
+    return (t >= 2 && n >= ratio * t) ? EvalStrategy::FiniteDifference : EvalStrategy::Horner;
+}
+
+// 通用BIGNUM路径的有限差分：v_k = Δ^k f(x0)，每前进一个点做 t-1 次 BN_mod_add
+// 结果写入 out[0..n)（由调用者释放）
+inline void eval_consecutive_bn(const std::vector<BIGNUM *> &coeffs, int x0, int n, const BIGNUM *mod, BN_CTX *ctx, BIGNUM **out)
+{
+    size_t d = coeffs.empty() ? 0 : coeffs.size() - 1;
+    std::vector<BIGNUM *> v(d + 1);
+    BIGNUM *x = BN_new();
+    for (size_t k = 0; k <= d; ++k)
+    {
+        BN_set_word(x, x0 + k);
+        v[k] = eval_poly(coeffs, x, mod);
+    }
+    for (size_t level = 1; level <= d; ++level)
+        for (size_t k = d; k >= level; --k)
+            BN_mod_sub(v[k], v[k], v[k - 1], mod, ctx);
+    for (int i = 0; i < n; ++i)
+    {
+        out[i] = BN_dup(v[0]);
+        for (size_t k = 0; k < d; ++k)
+            BN_mod_add(v[k], v[k], v[k + 1], mod, ctx);
+    }
+    for (auto b : v)
+        BN_free(b);
+    BN_free(x);
+}
+
+// 并行生成份额时每段至少包含的点数；有限差分每段要重新建一次差分表（约 t 次霍纳），
+// 段长取 4t 以上才能摊薄这部分开销
+inline size_t share_parallel_grain(size_t t, EvalStrategy strategy)
+{
+    return strategy == EvalStrategy::FiniteDifference ? std::max<size_t>(64, 4 * t) : 16;
+}
+
+// TODO: 学生需要实现此函数 - 根据系数生成份额
+inline std::vector<std::pair<int, BIGNUM *>> generate_shares(BIGNUM *prime, const std::vector<BIGNUM *> &coeffs, int n,
+                                                             EvalStrategy strategy = EvalStrategy::Auto)
+{
+    // 提示：
+    // 1. 创建存储份额的向量，每个份额是(序号, y值)的配对
+    // 2. 对于每个i从1到n，计算x=i, y=f(i)
+    // 3. 使用eval_poly计算多项式值
+    // 你的代码在这里
+    // std::cout << "Call " << __FUNCTION__ << "\n";
+    std::vector<std::pair<int, BIGNUM *>> shares;
+    if (n <= 0)
+        return shares;
+    // 份额按 x 分成连续的段并行计算，每段写入自己的下标区间，输出顺序与单线程一致
+    std::vector<BIGNUM *> ys(n);
+
+    // 定长域：系数只转换一次，之后全部是栈上运算
+    if (!with_fixed_field(prime, [&](auto field)
+                          {
+        using F = decltype(field);
+        std::vector<F> c;
+        for (auto coeff : coeffs)
+            c.push_back(F::from_bn(coeff));
+        if (strategy == EvalStrategy::Auto)
+            strategy = choose_eval_strategy(coeffs.size(), n, true);
+        parallel_for(n, share_parallel_grain(coeffs.size(), strategy), [&](size_t, size_t begin, size_t end)
+                     {
+            std::vector<F> fy(end - begin);
+            if (strategy == EvalStrategy::FiniteDifference)
+                fp_eval_consecutive(c, begin + 1, end - begin, fy.data());
+            else
+            {
+                F x = F::from_word(begin), one = F::one();
+                for (size_t i = begin; i < end; ++i)
+                {
+                    x += one; // x = i + 1
+                    fy[i - begin] = fp_eval_poly(c, x);
+                }
+            }
+            for (size_t i = begin; i < end; ++i)
+                ys[i] = fy[i - begin].to_bn(); }); }))
+    {
+        if (strategy == EvalStrategy::Auto)
+            strategy = choose_eval_strategy(coeffs.size(), n, false);
+        parallel_for(n, share_parallel_grain(coeffs.size(), strategy), [&](size_t, size_t begin, size_t end)
+                     {
+            BN_CTX *ctx = BN_CTX_new(); // 每段（每个线程）一个上下文，段内所有点共用
+            if (strategy == EvalStrategy::FiniteDifference)
+                eval_consecutive_bn(coeffs, begin + 1, end - begin, prime, ctx, &ys[begin]);
+            else
+            {
+                BIGNUM *x = BN_new();
+                for (size_t i = begin; i < end; ++i)
+                {
+                    // 霍纳法则 f(i+1)
+                    BN_set_word(x, i + 1);
+                    BIGNUM *y = BN_new();
+                    BN_zero(y);
+                    for (size_t k = coeffs.size(); k-- > 0;)
+                    {
+                        BN_mod_mul(y, y, x, prime, ctx);
+                        BN_mod_add(y, y, coeffs[k], prime, ctx);
+                    }
+                    ys[i] = y;
+                }
+                BN_free(x);
+            }
+            BN_CTX_free(ctx); });
+    }
+    for (int i = 1; i <= n; ++i)
+        shares.push_back({i, ys[i - 1]});
+    return shares;
+}
+
+// 重构秘密
+// 使用拉格朗日插值法从给定的份额重构原始秘密
+// 系数按份额持有者集合缓存（默认使用按模数共享的进程内缓存），同一集合重复重构时只需 t 次乘加
+inline BIGNUM *reconstruct_secret(BIGNUM *prime, const std::vector<std::pair<int, BIGNUM *>> &shares, LagrangeCache *cache = nullptr)
+{
+    LagrangeCache &c = cache ? *cache : lagrange_cache_for(prime);
+    if (BN_cmp(c.modulus(), prime) != 0)
+        throw std::runtime_error("系数缓存的模数不匹配");
+    return c.reconstruct(shares);
+}
+
+// 纠错重构：给出 n >= t + 2e 个份额，其中至多 e 个被篡改时仍能一次求出秘密（Gao 译码，O(n^2)）
+// 被判定为错误的份额序号写入 bad；错误过多时抛出异常。仅支持编译期特化的素数域
+inline BIGNUM *reconstruct_secret_robust(BIGNUM *prime, const std::vector<std::pair<int, BIGNUM *>> &shares, int t,
+                                         std::vector<int> &bad)
+{
+    if (t < 1 || shares.size() < (size_t)t)
+        throw std::runtime_error("份额数量不足门限 " + std::to_string(t));
+    BIGNUM *secret = nullptr;
+    if (!with_fixed_field(prime, [&](auto field)
+                          {
+        using F = decltype(field);
+        std::vector<F> xs, ys, f;
+        for (auto &s : shares)
+        {
+            if (s.first <= 0)
+                throw std::runtime_error("份额序号必须为正整数");
+            xs.push_back(F::from_word(s.first));
+            ys.push_back(F::from_bn(s.second));
+        }
+        std::vector<size_t> bad_idx;
+        if (!fp_gao_decode(xs, ys, t, f, bad_idx))
+            throw std::runtime_error("错误份额过多，最多可纠正 " + std::to_string((shares.size() - t) / 2) + " 个");
+        bad.clear();
+        for (size_t i : bad_idx)
+            bad.push_back(shares[i].first);
+        secret = (f.empty() ? F() : f[0]).to_bn(); }))
+        throw std::runtime_error("纠错重构仅支持内置素数域");
+    return secret;
+}
+
+// 打包（多秘密）Shamir分享：k 个秘密放在 x = -1, ..., -k，t-1 个随机值放在 x = -(k+1), ..., -(k+t-1)，
+// 唯一的 d = k+t-2 次多项式经过这 k+t-1 个点，份额为 f(1), ..., f(n)
+// 任意 t-1 个份额与全部秘密独立；任意 k+t-1 个份额可一次重构全部 k 个秘密
+// 每个份额仍是一个域元素，k 个秘密共用同一组 n 个份额，份额大小与计算量约为逐个分享的 1/k
+// 仅支持编译期特化的素数域（shamir 使用的 secp256k1 p）
+
+// 经过 (xs[i], ys[i]) 的插值多项式在 zs 各点的值；权重与各目标点按段并行计算
+template <class F>
+std::vector<F> packed_interpolate(const std::vector<F> &xs, const std::vector<F> &ys, const std::vector<F> &zs)
+{
+    size_t m = xs.size();
+    std::vector<F> wy(m), scratch, out(zs.size());
+    parallel_for(m, LAGRANGE_PARALLEL_GRAIN, [&](size_t, size_t begin, size_t end)
+                 {
+        for (size_t i = begin; i < end; ++i)
+            wy[i] = fp_barycentric_denominator(xs, i); });
+    fp_lagrange_finish(wy, F::one(), scratch); // 一次求逆得到全部 w_i，节点重复时抛出异常
+    for (size_t i = 0; i < m; ++i)
+        wy[i] *= ys[i];
+    parallel_for(zs.size(), 16, [&](size_t, size_t begin, size_t end)
+                 {
+        std::vector<F> s;
+        for (size_t i = begin; i < end; ++i)
+            out[i] = fp_interpolate_at(xs, ys, wy, zs[i], s); });
+    return out;
+}
+
+// 秘密所在的点 x = -(j+1)
+template <class F>
+F packed_secret_point(size_t j)
+{
+    return F() - F::from_word(j + 1);
+}
+
+// 生成打包份额，secrets 需已约化到 [0, prime)，返回 n 个 (x, f(x))
+inline std::vector<std::pair<int, BIGNUM *>> generate_packed_shares(BIGNUM *prime, const std::vector<BIGNUM *> &secrets, int t, int n)
+{
+    size_t k = secrets.size();
+    if (k == 0 || t < 1 || n < (int)k + t - 1)
+        throw std::runtime_error("打包分享要求 k >= 1, t >= 1 且 n >= k + t - 1");
+    std::vector<std::pair<int, BIGNUM *>> shares;
+    if (!with_fixed_field(prime, [&](auto field)
+                          {
+        using F = decltype(field);
+        std::vector<F> xs, ys, zs;
+        for (size_t j = 0; j < k + t - 1; ++j)
+        {
+            xs.push_back(packed_secret_point<F>(j));
+            if (j < k)
+                ys.push_back(F::from_bn(secrets[j]));
+            else
+            {
+                BIGNUM *r = rand_mod(prime); // 随机点保证任意 t-1 个份额不泄露秘密
+                ys.push_back(F::from_bn(r));
+                BN_clear_free(r);
+            }
+        }
+        for (int i = 1; i <= n; ++i)
+            zs.push_back(F::from_word(i));
+        std::vector<F> out = packed_interpolate(xs, ys, zs);
+        for (int i = 1; i <= n; ++i)
+            shares.push_back({i, out[i - 1].to_bn()}); }))
+        throw std::runtime_error("打包分享仅支持内置素数域");
+    return shares;
+}
+
+// 由至少 k+t-1 个份额重构全部 k 个秘密（给出的份额全部参与插值），返回值由调用者释放
+// 多项式次数为 k+t-2，份额不足 k+t-1 个时插值结果与秘密无关，必须拒绝
+inline std::vector<BIGNUM *> reconstruct_packed_secrets(BIGNUM *prime, const std::vector<std::pair<int, BIGNUM *>> &shares, int k, int t)
+{
+    if (k < 1 || t < 1)
+        throw std::runtime_error("打包重构要求 k >= 1 且 t >= 1");
+    if (shares.size() < (size_t)k + t - 1)
+        throw std::runtime_error("份额数量少于 k + t - 1 = " + std::to_string(k + t - 1));
+    std::vector<BIGNUM *> secrets;
+    if (!with_fixed_field(prime, [&](auto field)
+                          {
+        using F = decltype(field);
+        std::vector<F> xs, ys, zs;
+        for (auto &s : shares)
+        {
+            if (s.first <= 0)
+                throw std::runtime_error("份额序号必须为正整数");
+            xs.push_back(F::from_word(s.first));
+            ys.push_back(F::from_bn(s.second));
+        }
+        for (int j = 0; j < k; ++j)
+            zs.push_back(packed_secret_point<F>(j));
+        for (auto &v : packed_interpolate(xs, ys, zs))
+            secrets.push_back(v.to_bn()); }))
+        throw std::runtime_error("打包分享仅支持内置素数域");
+    return secrets;
+}
+
+// 按字节分享的份额文件头：魔数 "SSS8"、版本、x、t、保留字节，之后是与原文件等长的份额数据
+const char GF256_SHARE_MAGIC[4] = {'S', 'S', 'S', '8'};
+const size_t GF256_SHARE_HEADER = 8;
+const size_t GF256_BLOCK = 1 << 14; // 每次处理16KiB，t 个系数块可留在L2缓存中
+
+// GF(2^8) 按字节Shamir分享文件：每个字节是独立的秘密，多项式系数逐块随机生成
+// 流式分块读入、写出，内存占用约 (t+1) * GF256_BLOCK，与文件大小无关
+// 输出 out_prefix.1 ... out_prefix.n，返回各份额文件路径
+inline std::vector<std::string> share_file(const std::string &in_path, int t, int n, const std::string &out_prefix)
+{
+    if (t < 1 || n < t || n > 255)
+        throw std::runtime_error("GF(2^8)模式要求 1 <= t <= n <= 255");
+    std::ifstream in(in_path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("无法打开输入文件: " + in_path);
+
+    std::vector<std::string> paths;
+    std::vector<std::ofstream> outs(n);
+    std::vector<std::vector<uint8_t>> powers(n, std::vector<uint8_t>(t)); // powers[i][k] = x_i^k
+    for (int i = 0; i < n; ++i)
+    {
+        paths.push_back(out_prefix + "." + std::to_string(i + 1));
+        outs[i].open(paths.back(), std::ios::binary | std::ios::trunc);
+        if (!outs[i])
+            throw std::runtime_error("无法创建份额文件: " + paths.back());
+        char header[GF256_SHARE_HEADER] = {GF256_SHARE_MAGIC[0], GF256_SHARE_MAGIC[1], GF256_SHARE_MAGIC[2], GF256_SHARE_MAGIC[3],
+                                           1, (char)(i + 1), (char)t, 0};
+        outs[i].write(header, sizeof(header));
+        powers[i][0] = 1;
+        for (int k = 1; k < t; ++k)
+            powers[i][k] = gf256_mul(powers[i][k - 1], (uint8_t)(i + 1));
+    }
+
+    // coeffs 的第 k 块是所有字节多项式的第 k 次系数，第0块即秘密本身
+    // 各份额互相独立，按份额分段并行，每个线程使用自己的 y 缓冲区并只写自己的份额文件
+    std::vector<uint8_t> coeffs((size_t)t * GF256_BLOCK);
+    std::vector<std::vector<uint8_t>> ys(parallel_threads(), std::vector<uint8_t>(GF256_BLOCK));
+    while (in)
+    {
+        in.read((char *)coeffs.data(), GF256_BLOCK);
+        size_t len = (size_t)in.gcount();
+        if (len == 0)
+            break;
+        for (int k = 1; k < t; ++k)
+            if (RAND_bytes(coeffs.data() + k * GF256_BLOCK, (int)len) != 1)
+                throw std::runtime_error("RAND_bytes failed");
+        parallel_for(n, 4, [&](size_t chunk, size_t begin, size_t end)
+                     {
+            std::vector<uint8_t> &y = ys[chunk];
+            for (size_t i = begin; i < end; ++i)
+            {
+                // y = sum(c_k * x_i^k)，每一项都是一次整块的 dst ^= c * src
+                std::memcpy(y.data(), coeffs.data(), len);
+                for (int k = 1; k < t; ++k)
+                    gf256_mul_add(y.data(), coeffs.data() + k * GF256_BLOCK, powers[i][k], len);
+                outs[i].write((const char *)y.data(), len);
+            } });
+    }
+    OPENSSL_cleanse(coeffs.data(), coeffs.size()); // 擦除秘密与系数
+    for (auto &y : ys)
+        OPENSSL_cleanse(y.data(), y.size());
+    for (int i = 0; i < n; ++i)
+    {
+        outs[i].close();
+        if (!outs[i])
+            throw std::runtime_error("写入份额文件失败: " + paths[i]);
+    }
+    return paths;
+}
+
+// 从至少 t 个份额文件重构原文件（只使用前 t 个），同样流式处理
+inline void reconstruct_file(const std::string &out_path, const std::vector<std::string> &share_paths)
+{
+    std::vector<std::ifstream> ins;
+    std::vector<uint8_t> xs;
+    int t = 0;
+    std::streamoff payload = -1;
+    for (auto &path : share_paths)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            throw std::runtime_error("无法打开份额文件: " + path);
+        std::streamoff size = in.tellg();
+        in.seekg(0);
+        char header[GF256_SHARE_HEADER];
+        if (!in.read(header, sizeof(header)) || std::memcmp(header, GF256_SHARE_MAGIC, 4) != 0 || header[4] != 1)
+            throw std::runtime_error("份额文件格式错误: " + path);
+        if (t == 0)
+            t = (uint8_t)header[6];
+        if ((uint8_t)header[6] != t)
+            throw std::runtime_error("份额门限不一致: " + path);
+        if (payload >= 0 && size - (std::streamoff)GF256_SHARE_HEADER != payload)
+            throw std::runtime_error("份额长度不一致: " + path);
+        payload = size - GF256_SHARE_HEADER;
+        xs.push_back((uint8_t)header[5]);
+        ins.push_back(std::move(in));
+        if ((int)ins.size() == t)
+            break;
+    }
+    if (t == 0 || (int)ins.size() < t)
+        throw std::runtime_error("份额数量不足门限 " + std::to_string(t));
+
+    std::vector<uint8_t> l = gf256_basis_at_zero(xs); // 重复的x会抛出异常
+    std::ofstream out(out_path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("无法创建输出文件: " + out_path);
+
+    std::vector<uint8_t> buf(GF256_BLOCK), secret(GF256_BLOCK);
+    for (std::streamoff done = 0; done < payload;)
+    {
+        size_t len = (size_t)std::min<std::streamoff>(GF256_BLOCK, payload - done);
+        std::memset(secret.data(), 0, len);
+        for (int i = 0; i < t; ++i)
+        {
+            if (!ins[i].read((char *)buf.data(), len))
+                throw std::runtime_error("读取份额文件失败");
+            gf256_mul_add(secret.data(), buf.data(), l[i], len); // secret ^= l_i * y_i
+        }
+        out.write((const char *)secret.data(), len);
+        done += len;
+    }
+    OPENSSL_cleanse(secret.data(), secret.size());
+    if (!out.flush())
+        throw std::runtime_error("写入输出文件失败: " + out_path);
+}
+}
+
+#endif
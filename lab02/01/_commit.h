@@ -7,6 +7,8 @@
 #include <vector>
 #include <cstdlib>  // 用于 rand()
 
+#include "sha256_mb.hpp" // 多路 SHA-256，批量承诺
+
 /**
  * 将字节数组转换为十六进制字符串
  * @param buf 输入的字节数组
@@ -77,6 +79,40 @@ std::vector<unsigned char> commit(const std::string &message, const std::vector<
     return sha256(data);                                             // 对连接后的数据进行SHA256哈希运算，并返回哈希值
 }
 
+/**
+ * 批量计算承诺值 commit_i = SHA256(messages[i] || nonces[i])
+ * 多路 SHA-256 同时处理多条消息（AVX-512/AVX2/SSE2 每路一条，或 SHA-NI），消息与随机数不需要拼接
+ * @param messages 消息字符串
+ * @param nonces 随机数，与 messages 一一对应
+ * @param impl SHA-256 实现，默认按 CPU 自动选择
+ * @return 承诺值（SHA256哈希），与 messages 一一对应
+ */
+std::vector<std::vector<unsigned char>> commit_batch(const std::vector<std::string> &messages,
+                                                     const std::vector<std::vector<unsigned char>> &nonces,
+                                                     Sha256Impl impl = Sha256Impl::Auto)
+{
+    std::vector<Sha256Msg> msgs(messages.size());
+    for (size_t i = 0; i < messages.size(); ++i)
+        msgs[i] = {(const unsigned char *)messages[i].data(), messages[i].size(), nonces[i].data(), nonces[i].size()};
+    std::vector<std::vector<unsigned char>> out;
+    sha256_batch(msgs, out, impl);
+    return out;
+}
+
+/**
+ * 批量验证承诺
+ * @return valid[i] 表示 commits[i] 是否等于 SHA256(messages[i] || nonces[i])
+ */
+std::vector<bool> verify_batch(const std::vector<std::vector<unsigned char>> &commits, const std::vector<std::string> &messages,
+                               const std::vector<std::vector<unsigned char>> &nonces, Sha256Impl impl = Sha256Impl::Auto)
+{
+    std::vector<std::vector<unsigned char>> c = commit_batch(messages, nonces, impl);
+    std::vector<bool> valid(c.size());
+    for (size_t i = 0; i < c.size(); ++i)
+        valid[i] = c[i] == commits[i];
+    return valid;
+}
+
 /**
  * 创建承诺并以十六进制输出承诺值和随机数
  * @param message 输入的消息
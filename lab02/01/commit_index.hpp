@@ -0,0 +1,356 @@
+#ifndef _commit_index_hpp_
+#define _commit_index_hpp_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "search.hpp"
+
+/**
+ * 承诺查找表：预先算出 消息字典 × 随机数区间 中全部 SHA256(message || nonce) 的前 8 字节并排序写入磁盘，
+ * 查询时 mmap 整个文件二分查找，每次破解只是一次 O(log N) 的查找（前缀相同时重算完整摘要确认，不会误报）
+ *
+ * 文件布局（整数为本机字节序）：
+ *   头部 64 字节：魔数 "CMTIDX1\n"、nonce_bytes、保留、nonce_min、nonce_max、消息数、条目数、字典偏移、字典长度
+ *   前缀数组：条目数个 uint64，升序（摘要前 8 字节按大端解释）
+ *   编号数组：条目数个 uint32，与前缀一一对应，编号 = 消息下标 × 区间长度 + (nonce - nonce_min)
+ *   字典：各消息依次存放，每条以 '\n' 结尾
+ * 前缀与编号分开存放，二分查找只触及前缀数组；每个条目 12 字节，flag0~flag99 × 65536 个随机数约 75MB。
+ * 字典增长时 extend 只为新消息计算条目，再与已排序的旧条目归并成新文件，旧消息的编号不变。
+ */
+
+struct CommitIndexHeader
+{
+    char magic[8];
+    uint32_t nonce_bytes;
+    uint32_t reserved;
+    uint64_t nonce_min, nonce_max;
+    uint64_t messages, entries;
+    uint64_t dict_offset, dict_size;
+};
+static_assert(sizeof(CommitIndexHeader) == 64, "索引头部须为 64 字节");
+
+namespace commit_index_detail
+{
+    const char MAGIC[8] = {'C', 'M', 'T', 'I', 'D', 'X', '1', '\n'};
+
+    struct Entry
+    {
+        uint64_t prefix;
+        uint32_t id;
+        bool operator<(const Entry &o) const { return prefix != o.prefix ? prefix < o.prefix : id < o.id; }
+    };
+
+    // 为 messages[first..] 计算条目（编号从 first 条消息起算），多线程按消息分工，各线程写入互不重叠的区间
+    inline std::vector<Entry> compute_entries(const std::vector<std::string> &messages, size_t first,
+                                              const CommitIndexHeader &h, Sha256Impl impl)
+    {
+        const uint64_t range = h.nonce_max - h.nonce_min + 1;
+        const int NB = (int)h.nonce_bytes;
+        std::vector<Entry> entries((messages.size() - first) * range);
+        size_t threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), messages.size() - first);
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t)
+            pool.emplace_back([&, t]
+                              {
+                unsigned char nonces[16 * 8];
+                uint32_t digests[16][8];
+                for (size_t m = first + t; m < messages.size(); m += threads)
+                {
+                    Sha256Midstate mid((const unsigned char *)messages[m].data(), messages[m].size(), NB, impl);
+                    const int L = mid.lanes();
+                    Entry *out = entries.data() + (m - first) * range;
+                    for (uint64_t off = 0; off < range; off += L)
+                    {
+                        int valid = (int)std::min<uint64_t>(L, range - off);
+                        for (int l = 0; l < L; ++l)
+                        {
+                            uint64_t v = h.nonce_min + off + l;
+                            for (int k = NB - 1; k >= 0; --k, v >>= 8)
+                                nonces[l * NB + k] = (unsigned char)v; // 大端
+                        }
+                        mid.hash_lanes(nonces, digests);
+                        for (int l = 0; l < valid; ++l)
+                            out[off + l] = {(uint64_t)digests[l][0] << 32 | digests[l][1], (uint32_t)(m * range + off + l)};
+                    }
+                } });
+        for (auto &t : pool)
+            t.join();
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+
+    // 去掉空消息、重复消息和 skip 中已有的消息，保持原顺序
+    inline std::vector<std::string> unique_messages(const std::vector<std::string> &messages,
+                                                    std::unordered_set<std::string> skip = {})
+    {
+        std::vector<std::string> out;
+        for (auto &m : messages)
+        {
+            if (m.empty() || m.find('\n') != std::string::npos)
+                throw std::invalid_argument("消息不能为空或含换行符");
+            if (skip.insert(m).second)
+                out.push_back(m);
+        }
+        return out;
+    }
+}
+
+// 只读打开的查找表（整个文件 mmap，Windows 下读入内存）
+class CommitIndex
+{
+public:
+    explicit CommitIndex(const std::string &path)
+    {
+#ifndef _WIN32
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("无法打开索引: " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CommitIndexHeader))
+        {
+            close(fd);
+            throw std::runtime_error("索引格式错误: " + path);
+        }
+        size = (size_t)st.st_size;
+        void *map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED)
+            throw std::runtime_error("无法映射索引: " + path);
+        madvise(map, size, MADV_RANDOM); // 二分查找是随机访问，不需要预读
+        data = (const unsigned char *)map;
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw std::runtime_error("无法打开索引: " + path);
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        size = buffer.size();
+        data = (const unsigned char *)buffer.data();
+#endif
+        try
+        {
+            parse(path);
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    ~CommitIndex() { release(); }
+    CommitIndex(const CommitIndex &) = delete;
+    CommitIndex &operator=(const CommitIndex &) = delete;
+
+    // 查找承诺值（32 字节），返回全部对应的 (消息下标, 随机数)
+    std::vector<SearchHit> lookup(const unsigned char commit[32]) const
+    {
+        uint64_t key = 0;
+        for (int i = 0; i < 8; ++i)
+            key = key << 8 | commit[i];
+        std::vector<SearchHit> hits;
+        const uint64_t range = header.nonce_max - header.nonce_min + 1;
+        for (const uint64_t *p = std::lower_bound(prefixes, prefixes + header.entries, key);
+             p != prefixes + header.entries && *p == key; ++p)
+        {
+            uint32_t id = ids[p - prefixes];
+            if (id / range >= dict.size()) // 编号来自文件，损坏时不能用来下标字典
+                throw std::runtime_error("索引编号损坏: " + std::to_string(id));
+            SearchHit h = {(size_t)(id / range), header.nonce_min + id % range};
+            unsigned char nonce[8], digest[32];
+            uint64_t v = h.nonce;
+            for (int k = (int)header.nonce_bytes - 1; k >= 0; --k, v >>= 8)
+                nonce[k] = (unsigned char)v;
+            const std::string &m = dict[h.message];
+            Sha256Msg msg = {(const unsigned char *)m.data(), m.size(), nonce, header.nonce_bytes};
+            sha256_batch(&msg, 1, &digest);
+            if (std::memcmp(digest, commit, 32) == 0)
+                hits.push_back(h);
+        }
+        return hits;
+    }
+
+    const CommitIndexHeader &info() const { return header; }
+    const std::vector<std::string> &messages() const { return dict; }
+    const uint64_t *prefix_data() const { return prefixes; }
+    const uint32_t *id_data() const { return ids; }
+
+private:
+    void parse(const std::string &path)
+    {
+        std::memcpy(&header, data, sizeof(header));
+        const uint64_t range = header.nonce_max - header.nonce_min + 1;
+        // 先限制 entries 再相乘，避免 12 * entries 溢出后绕过长度检查
+        bool ok = std::memcmp(header.magic, commit_index_detail::MAGIC, 8) == 0 && header.nonce_bytes >= 1 &&
+                  header.nonce_bytes <= 8 && header.nonce_min <= header.nonce_max && range != 0 &&
+                  (header.nonce_bytes == 8 || header.nonce_max >> (8 * header.nonce_bytes) == 0) &&
+                  header.messages != 0 && header.entries / range == header.messages && header.entries % range == 0 &&
+                  header.entries <= (size - sizeof(header)) / 12 &&
+                  header.dict_offset == sizeof(header) + 12 * header.entries &&
+                  header.dict_size == size - header.dict_offset;
+        if (!ok)
+            throw std::runtime_error("索引格式错误: " + path);
+        prefixes = (const uint64_t *)(data + sizeof(header));
+        ids = (const uint32_t *)(data + sizeof(header) + 8 * header.entries);
+        const char *p = (const char *)data + header.dict_offset, *end = p + header.dict_size;
+        while (p < end)
+        {
+            const char *nl = (const char *)std::memchr(p, '\n', end - p);
+            if (!nl)
+                break;
+            dict.emplace_back(p, nl);
+            p = nl + 1;
+        }
+        if (p != end || dict.size() != header.messages)
+            throw std::runtime_error("索引字典损坏: " + path);
+    }
+
+    void release()
+    {
+#ifndef _WIN32
+        if (data)
+            munmap((void *)data, size);
+#endif
+        data = nullptr;
+    }
+
+    const unsigned char *data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    std::vector<char> buffer;
+#endif
+    CommitIndexHeader header;
+    const uint64_t *prefixes = nullptr;
+    const uint32_t *ids = nullptr;
+    std::vector<std::string> dict;
+};
+
+namespace commit_index_detail
+{
+    // 将旧表（可为空）与新条目按 (前缀, 编号) 归并写入 path：先写临时文件再改名
+    // 前缀数组与编号数组分两遍归并写出，两遍的顺序完全相同，不必把旧表读入内存
+    inline void write_index(const std::string &path, CommitIndexHeader h, const std::vector<std::string> &messages,
+                            const CommitIndex *old, const std::vector<Entry> &fresh)
+    {
+        const uint64_t old_n = old ? old->info().entries : 0;
+        std::memcpy(h.magic, MAGIC, 8);
+        h.reserved = 0;
+        h.messages = messages.size();
+        h.entries = old_n + fresh.size();
+        h.dict_offset = sizeof(h) + 12 * h.entries;
+        h.dict_size = 0;
+        for (auto &m : messages)
+            h.dict_size += m.size() + 1;
+
+        std::string tmp = path + ".tmp";
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error("无法写入索引: " + tmp);
+        out.write((const char *)&h, sizeof(h));
+        const size_t BUFFER = 1 << 16;
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            std::vector<uint64_t> prefix_buf;
+            std::vector<uint32_t> id_buf;
+            auto flush = [&]
+            {
+                if (pass == 0)
+                    out.write((const char *)prefix_buf.data(), 8 * prefix_buf.size());
+                else
+                    out.write((const char *)id_buf.data(), 4 * id_buf.size());
+                prefix_buf.clear();
+                id_buf.clear();
+            };
+            uint64_t i = 0;
+            size_t j = 0;
+            while (i < old_n || j < fresh.size())
+            {
+                // 前缀相同时旧条目在前：旧编号总是小于新编号
+                if (j == fresh.size() || (i < old_n && old->prefix_data()[i] <= fresh[j].prefix))
+                {
+                    prefix_buf.push_back(old->prefix_data()[i]);
+                    id_buf.push_back(old->id_data()[i]);
+                    ++i;
+                }
+                else
+                {
+                    prefix_buf.push_back(fresh[j].prefix);
+                    id_buf.push_back(fresh[j].id);
+                    ++j;
+                }
+                if (prefix_buf.size() == BUFFER)
+                    flush();
+            }
+            flush();
+        }
+        for (auto &m : messages)
+            out << m << '\n';
+        out.close();
+        if (!out)
+            throw std::runtime_error("无法写入索引: " + tmp);
+        std::remove(path.c_str());
+        if (std::rename(tmp.c_str(), path.c_str()) != 0)
+            throw std::runtime_error("无法写入索引: " + path);
+    }
+}
+
+// 为 消息字典 × [nonce_min, nonce_max] 建立查找表，重复的消息只保留第一条；返回条目数
+inline uint64_t commit_index_build(const std::string &path, const std::vector<std::string> &messages,
+                                   uint64_t nonce_min, uint64_t nonce_max, int nonce_bytes,
+                                   Sha256Impl impl = Sha256Impl::Auto)
+{
+    using namespace commit_index_detail;
+    std::vector<std::string> dict = unique_messages(messages);
+    if (dict.empty())
+        throw std::invalid_argument("消息字典为空");
+    if (nonce_bytes < 1 || nonce_bytes > 8)
+        throw std::invalid_argument("随机数字节数须为 1~8");
+    if (nonce_min > nonce_max || (nonce_bytes < 8 && nonce_max >> (8 * nonce_bytes)) || nonce_max - nonce_min == UINT64_MAX)
+        throw std::invalid_argument("随机数区间无效");
+    if ((unsigned __int128)dict.size() * (nonce_max - nonce_min + 1) > UINT32_MAX)
+        throw std::invalid_argument("搜索空间超过 2^32 个条目，不适合预计算");
+    CommitIndexHeader h = {};
+    h.nonce_bytes = nonce_bytes;
+    h.nonce_min = nonce_min;
+    h.nonce_max = nonce_max;
+    std::vector<Entry> entries = compute_entries(dict, 0, h, impl);
+    write_index(path, h, dict, nullptr, entries);
+    return entries.size();
+}
+
+// 把字典中新出现的消息加入已有的查找表（随机数区间不变）；返回新增的消息数，没有新消息时不改写文件
+inline size_t commit_index_extend(const std::string &path, const std::vector<std::string> &messages,
+                                  Sha256Impl impl = Sha256Impl::Auto)
+{
+    using namespace commit_index_detail;
+    CommitIndex old(path);
+    const CommitIndexHeader &h = old.info();
+    std::vector<std::string> added = unique_messages(
+        messages, std::unordered_set<std::string>(old.messages().begin(), old.messages().end()));
+    if (added.empty())
+        return 0;
+    std::vector<std::string> dict = old.messages();
+    dict.insert(dict.end(), added.begin(), added.end());
+    if ((unsigned __int128)dict.size() * (h.nonce_max - h.nonce_min + 1) > UINT32_MAX)
+        throw std::invalid_argument("搜索空间超过 2^32 个条目，不适合预计算");
+    std::vector<Entry> entries = compute_entries(dict, old.messages().size(), h, impl);
+    write_index(path, h, dict, &old, entries);
+    return added.size();
+}
+
+#endif // _commit_index_hpp_
@@ -1,54 +1,170 @@
 #include "_commit.h"
+#include "search.hpp"
 #include <thread>
-#include <chrono>  
+#include <chrono>
+#include <fstream>
+#include <csignal>
 using namespace std;
 
-string message_p1 = "flag"; 
-vector<string> message_list(100); // flag0 ~ flag99
+// 默认的搜索空间：实验给定的承诺值，消息为 flag0 ~ flag99，随机数为 4 字节的 0x00000000 ~ 0x00011177
+string message_p1 = "flag";
 int nonce_min = 0x00000000;
 int nonce_max = 0x00011177;
 
 string target = "d62cc82e34b963db7ae121557d6fe4d3c0f7fc383ab309b352e750dffcd2c9d5";
 
-int thread_num = 10;
-
 chrono::high_resolution_clock::time_point start_time;
 
+SearchEngine *engine = nullptr; // Ctrl-C 时取消搜索并保存检查点
+
 void __attribute__((constructor)) mian() {
 
 }
 
-void _create_commit(const std::string &message, const vector<unsigned char> &nonce)
+void _on_sigint(int)
 {
-    std::vector<unsigned char> C = commit(message, nonce); 
-    if (to_hex(C) == target) {
-        auto end_time = chrono::high_resolution_clock::now(); 
-        auto duration = chrono::duration_cast<chrono::milliseconds>(end_time - start_time).count();
-        cout << "Found! message: " << message << ", nonce: " << to_hex(nonce) << ", commit: " << to_hex(C) << endl;
-        cout << "Cracking completed in " << duration << " ms" << endl; 
-        exit(0);
-    }
+    if (engine)
+        engine->cancel();
 }
 
-int main() {
-    start_time = chrono::high_resolution_clock::now(); 
+void _usage(const char *prog)
+{
+    cerr << "使用说明: " << prog << " [选项]\n"
+         << "  --dict <file>          消息字典，每行一条消息（空行忽略），默认 flag0 ~ flag99\n"
+         << "  --nonce-min <n>        随机数下界，默认 0（可写 0x 开头的十六进制）\n"
+         << "  --nonce-max <n>        随机数上界（含），默认 0x11177\n"
+         << "  --nonce-bytes <k>      随机数按大端写成的字节数（1~8），默认 4\n"
+         << "  --target <hex>         目标承诺值，可重复；默认为实验给定的承诺值\n"
+         << "  --targets <file>       目标承诺值文件，每行一个（取行首字段，可直接使用 commit 的输出）\n"
+         << "  --all                  找出全部命中（默认每个目标找到一个命中即停止）\n"
+         << "  --threads <n>          工作线程数，默认全部CPU核心\n"
+         << "  --chunk <n>            每块的随机数个数，默认 4096\n"
+         << "  --checkpoint <file>    定期保存进度，中断（Ctrl-C）后以相同参数重新运行即可从该文件恢复\n"
+         << "  --quiet                不输出进度\n"
+         << "  --sha-impl <scalar|sha-ni|sse2|avx2|avx512|auto>\n";
+}
 
-    for (int i = 0; i < 100; i++) {
-        message_list[i] = message_p1 + to_string(i);
+vector<string> _read_lines(const string &path)
+{
+    ifstream in(path);
+    if (!in)
+        throw runtime_error("无法打开文件: " + path);
+    vector<string> lines;
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (!line.empty())
+            lines.push_back(line);
     }
-    vector<thread> threads;
-    for (int i = 0; i < thread_num; i++) {
-        threads.emplace_back([i]() {
-            for (int nonce_int = nonce_min + i; nonce_int <= nonce_max; nonce_int += thread_num) {
-                auto nonce = hex_to_bytes((stringstream() << hex << setw(8) << setfill('0') << nonce_int).str());
-                for (const auto &message : message_list) {
-                    _create_commit(message, nonce);
+    return lines;
+}
+
+array<unsigned char, 32> _parse_target(const string &hex)
+{
+    array<unsigned char, 32> t;
+    if (hex.size() != 64 || hex.find_first_not_of("0123456789abcdefABCDEF") != string::npos)
+        throw runtime_error("无效的目标承诺值: " + hex);
+    vector<unsigned char> b = hex_to_bytes(hex);
+    copy(b.begin(), b.end(), t.begin());
+    return t;
+}
+
+int main(int argc, char **argv) {
+    start_time = chrono::high_resolution_clock::now();
+
+    SearchConfig cfg;
+    cfg.nonce_min = nonce_min;
+    cfg.nonce_max = nonce_max;
+    try {
+        for (int i = 1; i < argc; i++) {
+            string opt = argv[i];
+            if (opt == "--all") {
+                cfg.find_all = true;
+                continue;
+            }
+            if (opt == "--quiet") {
+                cfg.progress_interval = 0;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                _usage(argv[0]);
+                return 1;
+            }
+            string val = argv[++i];
+            if (opt == "--dict")
+                cfg.messages = _read_lines(val);
+            else if (opt == "--nonce-min")
+                cfg.nonce_min = stoull(val, nullptr, 0);
+            else if (opt == "--nonce-max")
+                cfg.nonce_max = stoull(val, nullptr, 0);
+            else if (opt == "--nonce-bytes")
+                cfg.nonce_bytes = stoi(val);
+            else if (opt == "--target")
+                cfg.targets.push_back(_parse_target(val));
+            else if (opt == "--targets") {
+                for (const string &line : _read_lines(val)) {
+                    string t;
+                    if ((istringstream(line) >> t) && t[0] != '#')
+                        cfg.targets.push_back(_parse_target(t));
                 }
             }
-        });
-    }
-    for (auto &t : threads) {
-        t.join();
+            else if (opt == "--threads")
+                cfg.threads = stoul(val);
+            else if (opt == "--chunk")
+                cfg.chunk_nonces = stoull(val, nullptr, 0);
+            else if (opt == "--checkpoint")
+                cfg.checkpoint = val;
+            else if (opt == "--sha-impl") {
+                if (!sha256_impl_from_name(val, cfg.impl) || !sha256_impl_supported(cfg.impl))
+                    throw runtime_error("不支持的SHA-256实现: " + val);
+            }
+            else {
+                _usage(argv[0]);
+                return 1;
+            }
+        }
+        if (cfg.messages.empty()) {
+            for (int i = 0; i < 100; i++)
+                cfg.messages.push_back(message_p1 + to_string(i));
+        }
+        if (cfg.targets.empty())
+            cfg.targets.push_back(_parse_target(target));
+
+        SearchEngine search(cfg);
+        engine = &search;
+        signal(SIGINT, _on_sigint);
+        vector<SearchHit> hits = search.run();
+        engine = nullptr;
+
+        for (const SearchHit &h : hits) {
+            vector<unsigned char> nonce(search.nonce_bytes());
+            uint64_t v = h.nonce;
+            for (int k = search.nonce_bytes() - 1; k >= 0; k--, v >>= 8)
+                nonce[k] = (unsigned char)v;
+            const string &message = search.message(h.message);
+            cout << "Found! message: " << message << ", nonce: " << to_hex(nonce) << ", commit: " << to_hex(commit(message, nonce)) << endl;
+        }
+        auto duration = chrono::duration_cast<chrono::milliseconds>(chrono::high_resolution_clock::now() - start_time).count();
+        if (search.targets() > 1)
+            cout << "Resolved " << search.targets_found() << "/" << search.targets() << " targets" << endl;
+        if (search.cancelled())
+            cout << "已中断" << (cfg.checkpoint.empty() ? "" : "，进度已保存到 " + cfg.checkpoint) << endl;
+        else if (hits.empty())
+            cout << "Not found" << endl;
+        else
+            cout << "Cracking completed in " << duration << " ms" << endl;
+
+        // 吞吐：按实际能并行的核数折算每核的候选数/秒
+        double sec = search.seconds_elapsed();
+        unsigned cores = (unsigned)min<size_t>(search.threads(), max(1u, thread::hardware_concurrency()));
+        double rate = sec > 0 ? search.tested() / sec / 1e6 : 0;
+        cout << "Tested " << search.tested() << " candidates in " << fixed << setprecision(1) << sec * 1000 << " ms: "
+             << setprecision(2) << rate << " M/s, " << rate / cores << " M/s per core (" << sha256_impl_name(search.impl())
+             << " x" << search.lanes() << ", " << search.threads() << " threads on " << cores << " cores)" << endl;
+        return search.cancelled() ? 2 : 0;
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
     }
-    return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,156 @@
+#include "_commit.h"
+#include "commit_index.hpp"
+#include <chrono>
+#include <fstream>
+using namespace std;
+
+// 默认的预计算空间：消息 flag0 ~ flag99，随机数为 generate_nonce_small 产生的 4 字节 0 ~ 65535
+string message_p1 = "flag";
+uint64_t nonce_min = 0x0000;
+uint64_t nonce_max = 0xffff;
+
+void _usage(const char *prog)
+{
+    cerr << "使用说明:\n"
+         << "  " << prog << " build <index> [--dict <file>] [--nonce-min <n>] [--nonce-max <n>] [--nonce-bytes <k>]\n"
+         << "      预计算 字典 × 随机数区间 的全部承诺值，默认 flag0 ~ flag99 × 0 ~ 0xffff（4 字节）\n"
+         << "  " << prog << " extend <index> <dict>\n"
+         << "      把字典中新出现的消息加入已有的查找表\n"
+         << "  " << prog << " lookup <index> [<commit_hex>...] [--targets <file>]\n"
+         << "      查找承诺值（--targets 文件每行取行首字段，可直接使用 commit 的输出）\n"
+         << "  " << prog << " info <index>\n"
+         << "  以上命令均可加 --sha-impl <scalar|sha-ni|sse2|avx2|avx512|auto>\n";
+}
+
+vector<string> _read_lines(const string &path)
+{
+    ifstream in(path);
+    if (!in)
+        throw runtime_error("无法打开文件: " + path);
+    vector<string> lines;
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (!line.empty())
+            lines.push_back(line);
+    }
+    return lines;
+}
+
+vector<unsigned char> _parse_target(const string &hex)
+{
+    if (hex.size() != 64 || hex.find_first_not_of("0123456789abcdefABCDEF") != string::npos)
+        throw runtime_error("无效的目标承诺值: " + hex);
+    return hex_to_bytes(hex);
+}
+
+double _ms_since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        _usage(argv[0]);
+        return 1;
+    }
+    string cmd = argv[1], index = argv[2];
+    vector<string> dict, targets, positional;
+    uint64_t lo = nonce_min, hi = nonce_max;
+    int nonce_bytes = 4;
+    Sha256Impl impl = Sha256Impl::Auto;
+    try {
+        for (int i = 3; i < argc; i++) {
+            string opt = argv[i];
+            if (opt.rfind("--", 0) != 0) {
+                positional.push_back(opt);
+                continue;
+            }
+            if (i + 1 >= argc) {
+                _usage(argv[0]);
+                return 1;
+            }
+            string val = argv[++i];
+            if (opt == "--dict")
+                dict = _read_lines(val);
+            else if (opt == "--nonce-min")
+                lo = stoull(val, nullptr, 0);
+            else if (opt == "--nonce-max")
+                hi = stoull(val, nullptr, 0);
+            else if (opt == "--nonce-bytes")
+                nonce_bytes = stoi(val);
+            else if (opt == "--targets") {
+                for (const string &line : _read_lines(val)) {
+                    string t;
+                    if ((istringstream(line) >> t) && t[0] != '#')
+                        targets.push_back(t);
+                }
+            }
+            else if (opt == "--sha-impl") {
+                if (!sha256_impl_from_name(val, impl) || !sha256_impl_supported(impl))
+                    throw runtime_error("不支持的SHA-256实现: " + val);
+            }
+            else {
+                _usage(argv[0]);
+                return 1;
+            }
+        }
+
+        auto start = chrono::steady_clock::now();
+        if (cmd == "build" && positional.empty()) {
+            if (dict.empty()) {
+                for (int i = 0; i < 100; i++)
+                    dict.push_back(message_p1 + to_string(i));
+            }
+            uint64_t n = commit_index_build(index, dict, lo, hi, nonce_bytes, impl);
+            cout << "Indexed " << n << " commitments in " << fixed << setprecision(1) << _ms_since(start) << " ms" << endl;
+        }
+        else if (cmd == "extend" && positional.size() == 1 && dict.empty()) {
+            size_t added = commit_index_extend(index, _read_lines(positional[0]), impl);
+            cout << "Added " << added << " messages in " << fixed << setprecision(1) << _ms_since(start) << " ms" << endl;
+        }
+        else if (cmd == "lookup") {
+            targets.insert(targets.end(), positional.begin(), positional.end());
+            if (targets.empty()) {
+                _usage(argv[0]);
+                return 1;
+            }
+            CommitIndex idx(index);
+            const CommitIndexHeader &h = idx.info();
+            start = chrono::steady_clock::now();
+            size_t found = 0;
+            for (const string &t : targets) {
+                vector<unsigned char> C = _parse_target(t);
+                vector<SearchHit> hits = idx.lookup(C.data());
+                for (const SearchHit &hit : hits) {
+                    vector<unsigned char> nonce(h.nonce_bytes);
+                    uint64_t v = hit.nonce;
+                    for (int k = (int)h.nonce_bytes - 1; k >= 0; k--, v >>= 8)
+                        nonce[k] = (unsigned char)v;
+                    cout << "Found! message: " << idx.messages()[hit.message] << ", nonce: " << to_hex(nonce) << ", commit: " << to_hex(C) << endl;
+                }
+                if (hits.empty())
+                    cout << "Not found: " << to_hex(C) << endl;
+                else
+                    found++;
+            }
+            cout << "Looked up " << targets.size() << " commitments (" << found << " found) in " << fixed << setprecision(3)
+                 << _ms_since(start) << " ms" << endl;
+        }
+        else if (cmd == "info" && positional.empty()) {
+            CommitIndex idx(index);
+            const CommitIndexHeader &h = idx.info();
+            cout << "messages: " << h.messages << "\nnonces: 0x" << hex << h.nonce_min << " ~ 0x" << h.nonce_max << dec
+                 << " (" << h.nonce_bytes << " bytes)\nentries: " << h.entries << endl;
+        }
+        else {
+            _usage(argv[0]);
+            return 1;
+        }
+        return 0;
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+}
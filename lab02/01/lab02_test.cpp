@@ -0,0 +1,287 @@
+#include "commit_index.hpp"
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <utility>
+
+// 搜索引擎与查找表的测试：直接调用 SearchEngine / CommitIndex，不经过命令行程序
+
+// 计算 SHA256(message || nonce)，nonce 按大端写成 nonce_bytes 字节
+std::array<unsigned char, 32> commit_of(const std::string &message, uint64_t nonce, int nonce_bytes)
+{
+    unsigned char n[8], digest[32];
+    for (int k = nonce_bytes - 1; k >= 0; --k, nonce >>= 8)
+        n[k] = (unsigned char)nonce;
+    Sha256Msg in = {(const unsigned char *)message.data(), message.size(), n, (size_t)nonce_bytes};
+    sha256_batch(&in, 1, &digest);
+    std::array<unsigned char, 32> t;
+    std::copy(digest, digest + 32, t.begin());
+    return t;
+}
+
+// 消息 prefix0 ~ prefix{count-1}
+std::vector<std::string> make_messages(const std::string &prefix, int count)
+{
+    std::vector<std::string> messages;
+    for (int i = 0; i < count; i++)
+        messages.push_back(prefix + std::to_string(i));
+    return messages;
+}
+
+// 命中集合恰好等于期望的 (消息, 随机数) 集合
+bool same_hits(const std::vector<SearchHit> &hits, const std::set<std::pair<size_t, uint64_t>> &expected)
+{
+    std::set<std::pair<size_t, uint64_t>> got;
+    for (const SearchHit &h : hits)
+        got.insert({h.message, h.nonce});
+    return got.size() == hits.size() && got == expected;
+}
+
+// 随机数区间到 2^64-1：块尾不能回绕，最后一个随机数也要搜到，测试数按区间长度计
+bool test_range_end(uint64_t nonce_min)
+{
+    SearchConfig cfg;
+    cfg.messages = make_messages("flag", 10);
+    cfg.nonce_bytes = 8;
+    cfg.nonce_min = nonce_min;
+    cfg.nonce_max = UINT64_MAX;
+    cfg.threads = 2;
+    cfg.chunk_nonces = 64;
+    cfg.find_all = true;
+    cfg.progress_interval = 0;
+    std::set<std::pair<size_t, uint64_t>> expected = {{7, UINT64_MAX}, {3, UINT64_MAX - 1}, {0, nonce_min}};
+    for (auto &e : expected)
+        cfg.targets.push_back(commit_of(cfg.messages[e.first], e.second, cfg.nonce_bytes));
+
+    SearchEngine search(cfg);
+    std::vector<SearchHit> hits = search.run();
+    if (!same_hits(hits, expected))
+    {
+        std::cerr << "range end: hits mismatch\n";
+        return false;
+    }
+    if (search.tested() != (UINT64_MAX - nonce_min + 1) * cfg.messages.size())
+    {
+        std::cerr << "range end: tested " << search.tested() << "\n";
+        return false;
+    }
+    return true;
+}
+
+// 多线程、小块：各线程互相偷取剩余的块，全部命中都要找到且每个候选恰好测试一次
+bool test_stealing(size_t threads)
+{
+    SearchConfig cfg;
+    cfg.messages = make_messages("msg", 5);
+    cfg.nonce_min = 1000;
+    cfg.nonce_max = 1000 + 200000 - 1;
+    cfg.threads = threads;
+    cfg.chunk_nonces = 64;
+    cfg.find_all = true;
+    cfg.progress_interval = 0;
+    std::set<std::pair<size_t, uint64_t>> expected = {{0, 1000}, {4, 1063}, {2, 77777}, {1, 150000}, {3, 200999}};
+    for (auto &e : expected)
+        cfg.targets.push_back(commit_of(cfg.messages[e.first], e.second, cfg.nonce_bytes));
+
+    SearchEngine search(cfg);
+    std::vector<SearchHit> hits = search.run();
+    if (!same_hits(hits, expected))
+    {
+        std::cerr << "stealing: hits mismatch\n";
+        return false;
+    }
+    if (search.tested() != 200000 * cfg.messages.size())
+    {
+        std::cerr << "stealing: tested " << search.tested() << "\n";
+        return false;
+    }
+    return true;
+}
+
+// 中途取消后从检查点恢复：两次运行合起来恰好测试全部候选，命中不重不漏
+bool test_checkpoint_resume()
+{
+    std::string path = "lab02_test.checkpoint";
+    std::remove(path.c_str());
+    SearchConfig cfg;
+    cfg.messages = make_messages("flag", 4);
+    cfg.nonce_min = 0;
+    cfg.nonce_max = (1u << 22) - 1;
+    cfg.threads = 4;
+    cfg.chunk_nonces = 1024;
+    cfg.find_all = true;
+    cfg.progress_interval = 0;
+    cfg.checkpoint = path;
+    std::set<std::pair<size_t, uint64_t>> expected = {{0, 5}, {3, 1u << 21}, {1, (1u << 22) - 1}};
+    for (auto &e : expected)
+        cfg.targets.push_back(commit_of(cfg.messages[e.first], e.second, cfg.nonce_bytes));
+    uint64_t total = (cfg.nonce_max - cfg.nonce_min + 1) * cfg.messages.size();
+
+    uint64_t first_tested;
+    {
+        SearchEngine search(cfg);
+        // 至少完成一块后取消
+        std::thread canceller([&search]
+                              {
+            while (search.tested() == 0)
+                std::this_thread::yield();
+            search.cancel(); });
+        search.run();
+        canceller.join();
+        first_tested = search.tested();
+        if (!search.cancelled() || first_tested == 0 || first_tested >= total)
+        {
+            std::cerr << "checkpoint: first run tested " << first_tested << "\n";
+            return false;
+        }
+        if (!std::ifstream(path))
+        {
+            std::cerr << "checkpoint: file not saved\n";
+            return false;
+        }
+    }
+
+    SearchEngine search(cfg);
+    std::vector<SearchHit> hits = search.run();
+    if (search.cancelled() || !same_hits(hits, expected))
+    {
+        std::cerr << "checkpoint: hits mismatch after resume\n";
+        return false;
+    }
+    if (first_tested + search.tested() != total)
+    {
+        std::cerr << "checkpoint: tested " << first_tested << " + " << search.tested() << " != " << total << "\n";
+        return false;
+    }
+    if (std::ifstream(path))
+    {
+        std::cerr << "checkpoint: file not removed after completion\n";
+        return false;
+    }
+    return true;
+}
+
+// 查找表：正常查找能找到，编号被改坏（超出字典）时报错而不是越界读字典
+bool test_index_corrupt_id()
+{
+    std::string path = "lab02_test.idx";
+    std::vector<std::string> messages = make_messages("flag", 3);
+    uint64_t n = commit_index_build(path, messages, 0, 255, 4);
+    std::array<unsigned char, 32> C = commit_of(messages[2], 200, 4);
+    {
+        CommitIndex idx(path);
+        std::vector<SearchHit> hits = idx.lookup(C.data());
+        if (n != 3 * 256 || hits.size() != 1 || hits[0].message != 2 || hits[0].nonce != 200)
+        {
+            std::cerr << "index: lookup failed\n";
+            return false;
+        }
+    }
+    // 把 C 对应条目的编号改成 3 × 256（第 3 条消息，不存在）
+    uint64_t key = 0;
+    for (int i = 0; i < 8; ++i)
+        key = key << 8 | C[i];
+    size_t slot;
+    {
+        CommitIndex idx(path);
+        slot = std::lower_bound(idx.prefix_data(), idx.prefix_data() + n, key) - idx.prefix_data();
+    }
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        uint32_t bad = 3 * 256;
+        f.seekp(sizeof(CommitIndexHeader) + 8 * n + 4 * slot);
+        f.write((const char *)&bad, sizeof(bad));
+    }
+    bool thrown = false;
+    try
+    {
+        CommitIndex idx(path);
+        idx.lookup(C.data());
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    std::remove(path.c_str());
+    if (!thrown)
+        std::cerr << "index: corrupt id not detected\n";
+    return thrown;
+}
+
+// 查找表头部被篡改：12 × 条目数溢出后凑出合法的字典偏移、随机数超出 nonce_bytes 能表示的范围，都要报错
+bool test_index_bad_header()
+{
+    std::string path = "lab02_test.idx";
+    commit_index_build(path, make_messages("flag", 3), 0, 255, 4);
+    CommitIndexHeader wide;
+    {
+        CommitIndex idx(path);
+        wide = idx.info();
+    }
+    wide.nonce_bytes = 1;
+    wide.nonce_min = 0x100;
+    wide.nonce_max = 0x1ff;
+    // 3 条消息 × 区间 2^62+5：12 × 条目数回绕为 180，头部、180 字节填充和 3 行字典恰好凑成一个文件
+    CommitIndexHeader overflow = wide;
+    overflow.nonce_bytes = 8;
+    overflow.nonce_min = 0;
+    overflow.nonce_max = (1ull << 62) + 4;
+    overflow.messages = 3;
+    overflow.entries = 3 * ((1ull << 62) + 5);
+    overflow.dict_offset = sizeof(CommitIndexHeader) + 12 * overflow.entries;
+    overflow.dict_size = 6;
+
+    auto rejected = [&path]
+    {
+        try
+        {
+            CommitIndex idx(path);
+        }
+        catch (const std::runtime_error &)
+        {
+            return true;
+        }
+        return false;
+    };
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.write((const char *)&wide, sizeof(wide));
+    }
+    bool wide_ok = rejected();
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f.write((const char *)&overflow, sizeof(overflow));
+        f << std::string(overflow.dict_offset - sizeof(overflow), '\0') << "a\nb\nc\n";
+    }
+    bool overflow_ok = rejected();
+    std::remove(path.c_str());
+    if (!wide_ok)
+        std::cerr << "index: nonce_max beyond nonce_bytes accepted\n";
+    if (!overflow_ok)
+        std::cerr << "index: overflowing entry count accepted\n";
+    return wide_ok && overflow_ok;
+}
+
+int main()
+{
+    bool re = test_range_end(0xffffffffffffff00);     // 区间末尾的 256 个随机数
+    bool rb = test_range_end(0xfffffffffffff000);     // 跨多块到达 2^64-1
+    bool ws = test_stealing(8);                       // 多线程互相偷取
+    bool w1 = test_stealing(1);                       // 单线程
+    bool cp = test_checkpoint_resume();               // 检查点恢复
+    bool ic = test_index_corrupt_id();                // 查找表编号损坏
+    bool ih = test_index_bad_header();                // 查找表头部篡改
+
+    std::cout << "Search range end test: " << (re ? "PASS" : "FAIL") << "\n";
+    std::cout << "Search range end (multi-chunk) test: " << (rb ? "PASS" : "FAIL") << "\n";
+    std::cout << "Search work stealing test: " << (ws ? "PASS" : "FAIL") << "\n";
+    std::cout << "Search single thread test: " << (w1 ? "PASS" : "FAIL") << "\n";
+    std::cout << "Search checkpoint resume test: " << (cp ? "PASS" : "FAIL") << "\n";
+    std::cout << "Index corrupt id test: " << (ic ? "PASS" : "FAIL") << "\n";
+    std::cout << "Index bad header test: " << (ih ? "PASS" : "FAIL") << "\n";
+
+    if (re && rb && ws && w1 && cp && ic && ih)
+        return 0;
+    return 1;
+}
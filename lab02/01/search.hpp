@@ -0,0 +1,503 @@
+#ifndef _search_hpp_
+#define _search_hpp_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sha256_mb.hpp"
+
+/**
+ * 承诺穷举搜索引擎：在 消息字典 × 随机数区间 中寻找 SHA256(message || nonce) 等于某个目标的组合
+ *
+ * 搜索空间按 (随机数块, 消息) 切成块，块号 c 对应第 c / M 个随机数块与第 c % M 条消息（M 为消息数），
+ * 小随机数优先，与原先逐个随机数遍历全部消息的顺序一致。每个工作线程先领一段连续的块号，
+ * 做完自己的再从其他线程的剩余区间尾部偷走一半（work stealing），负载不均时也能一起结束。
+ * 完成的块记在位图里，可定期写入检查点文件，中断后从检查点恢复；取消只设置原子标志，可在信号处理函数中调用。
+ */
+
+// 命中：第 message 条消息与随机数 nonce
+struct SearchHit
+{
+    size_t message;
+    uint64_t nonce;
+};
+
+/**
+ * 目标摘要的开放寻址哈希表（线性探测），一次扫描即可同时比对成千上万个目标
+ *
+ * 摘要本身是均匀随机的，直接取前 64 位作键、键的低位作槽号，不再另算哈希。
+ * 槽数为 2 的幂且不少于目标数的 2 倍（装载因子不超过 1/2），槽里只放 8 字节的键，
+ * 一条缓存行容纳 8 个槽；未命中（绝大多数情况）通常只读一个槽，键相同时再比较完整的 32 字节。
+ * 键 0 用作空槽标记，前 64 位恰好为 0 的目标单独存放。
+ */
+class TargetSet
+{
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    TargetSet() = default;
+
+    // 重复的目标只保留一个，编号为去重后的下标
+    explicit TargetSet(const std::vector<std::array<unsigned char, 32>> &targets)
+    {
+        size_t capacity = 16;
+        while (capacity < 2 * targets.size())
+            capacity *= 2;
+        keys.assign(capacity, 0);
+        slot_index.assign(capacity, NONE);
+        mask = capacity - 1;
+        for (auto &t : targets)
+        {
+            std::array<uint32_t, 8> w;
+            sha256_digest_words(t.data(), w.data());
+            if (find(w.data()) != NONE)
+                continue;
+            uint32_t index = (uint32_t)words.size();
+            words.push_back(w);
+            uint64_t key = (uint64_t)w[0] << 32 | w[1];
+            if (key == 0)
+            {
+                zero_keys.push_back(index);
+                continue;
+            }
+            size_t i = key & mask;
+            while (keys[i] != 0)
+                i = (i + 1) & mask;
+            keys[i] = key;
+            slot_index[i] = index;
+        }
+    }
+
+    // 摘要（8 个大端字）对应的目标编号，不在集合中返回 NONE
+    uint32_t find(const uint32_t w[8]) const
+    {
+        uint64_t key = (uint64_t)w[0] << 32 | w[1];
+        if (key == 0)
+        {
+            for (uint32_t index : zero_keys)
+                if (std::memcmp(words[index].data(), w, 32) == 0)
+                    return index;
+            return NONE;
+        }
+        for (size_t i = key & mask;; i = (i + 1) & mask)
+        {
+            uint64_t k = keys[i];
+            if (k == key && std::memcmp(words[slot_index[i]].data(), w, 32) == 0)
+                return slot_index[i];
+            if (k == 0)
+                return NONE;
+        }
+    }
+
+    // 去重后的目标数
+    size_t size() const { return words.size(); }
+
+private:
+    std::vector<uint64_t> keys;        // 各槽的键（摘要前 64 位），0 为空槽
+    std::vector<uint32_t> slot_index;  // 各槽的目标编号，只在键相同时读取
+    std::vector<uint32_t> zero_keys;   // 前 64 位为 0 的目标
+    std::vector<std::array<uint32_t, 8>> words; // 按编号存放的完整摘要
+    size_t mask = 0;
+};
+
+struct SearchConfig
+{
+    std::vector<std::string> messages;                 // 消息字典
+    uint64_t nonce_min = 0, nonce_max = 0;             // 随机数区间（闭区间）
+    int nonce_bytes = 4;                               // 随机数按大端写成的字节数（1~8）
+    std::vector<std::array<unsigned char, 32>> targets; // 目标承诺值
+    size_t threads = 0;                                // 工作线程数，0 表示全部CPU核心
+    uint64_t chunk_nonces = 4096;                      // 每块的随机数个数（空间过大时自动放大，见 SearchEngine）
+    bool find_all = false;                             // false：每个目标都找到一个命中后停止；true：搜完整个空间
+    Sha256Impl impl = Sha256Impl::Auto;
+    std::string checkpoint;                            // 检查点文件，为空表示不保存
+    double checkpoint_interval = 10;                   // 检查点的保存间隔（秒）
+    double progress_interval = 1;                      // 进度输出到标准错误的间隔（秒），0 表示不输出
+};
+
+class SearchEngine
+{
+public:
+    explicit SearchEngine(const SearchConfig &config) : cfg(config)
+    {
+        if (cfg.messages.empty())
+            throw std::invalid_argument("消息字典为空");
+        if (cfg.targets.empty())
+            throw std::invalid_argument("没有目标承诺值");
+        if (cfg.nonce_bytes < 1 || cfg.nonce_bytes > 8)
+            throw std::invalid_argument("随机数字节数须为 1~8");
+        if (cfg.nonce_min > cfg.nonce_max || (cfg.nonce_bytes < 8 && cfg.nonce_max >> (8 * cfg.nonce_bytes)) ||
+            cfg.nonce_max - cfg.nonce_min == UINT64_MAX)
+            throw std::invalid_argument("随机数区间无效");
+        if (cfg.threads == 0)
+            cfg.threads = std::max(1u, std::thread::hardware_concurrency());
+        target_set = TargetSet(cfg.targets);
+        resolved.assign(target_set.size(), false);
+        unresolved = target_set.size();
+
+        // 块数上限 2^24：位图（与检查点）不超过 2MB，必要时放大每块的随机数个数，块大小取 64 的倍数以填满所有通道
+        uint64_t range = cfg.nonce_max - cfg.nonce_min + 1, m = cfg.messages.size();
+        uint64_t min_chunk = (range / ((uint64_t)1 << 24) + 1) * m;
+        chunk = (std::max<uint64_t>(std::max<uint64_t>(cfg.chunk_nonces, 1), min_chunk) + 63) / 64 * 64;
+        blocks = (range - 1) / chunk + 1;
+        total = blocks * m;
+        std::vector<std::atomic<uint64_t>>((total + 63) / 64).swap(done);
+        fingerprint = space_fingerprint();
+    }
+
+    // 从检查点恢复已完成的块与已找到的命中；文件不存在返回 false，与当前搜索空间不符时抛出异常
+    bool load_checkpoint(const std::string &path)
+    {
+        std::ifstream in(path);
+        if (!in)
+            return false;
+        std::string line, key, value;
+        bool space_ok = false;
+        while (std::getline(in, line))
+        {
+            std::istringstream iss(line);
+            if (!(iss >> key) || key[0] == '#')
+                continue;
+            if (key == "space")
+            {
+                iss >> value;
+                space_ok = value == fingerprint;
+                if (!space_ok)
+                    throw std::runtime_error("检查点与当前搜索空间不符: " + path);
+            }
+            else if (key == "done" && space_ok)
+            {
+                iss >> value;
+                if (value.size() != 16 * done.size())
+                    throw std::runtime_error("检查点位图长度错误: " + path);
+                for (size_t i = 0; i < done.size(); ++i)
+                    done[i] = std::stoull(value.substr(16 * i, 16), nullptr, 16);
+            }
+            else if (key == "hit" && space_ok)
+            {
+                SearchHit h;
+                if (!(iss >> h.message >> h.nonce) || h.message >= cfg.messages.size())
+                    throw std::runtime_error("检查点命中记录错误: " + path);
+                mark_resolved(h);
+                hits.push_back(h);
+            }
+        }
+        if (!space_ok)
+            throw std::runtime_error("检查点格式错误: " + path);
+        for (uint64_t w : done)
+            resumed += __builtin_popcountll(w);
+        return true;
+    }
+
+    // 先写临时文件再改名，保存过程中被打断也不会损坏原检查点
+    void save_checkpoint(const std::string &path)
+    {
+        std::ostringstream out;
+        out << "# crack checkpoint v1\nspace " << fingerprint << "\nchunks " << total << "\ndone ";
+        out << std::hex << std::setfill('0');
+        for (auto &w : done)
+            out << std::setw(16) << w.load(std::memory_order_relaxed);
+        out << std::dec << "\n";
+        {
+            std::lock_guard<std::mutex> lock(hits_mutex);
+            for (auto &h : hits)
+                out << "hit " << h.message << " " << h.nonce << "\n";
+        }
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream f(tmp);
+            if (!f || !(f << out.str()))
+                throw std::runtime_error("无法写入检查点: " + tmp);
+        }
+        std::remove(path.c_str());
+        if (std::rename(tmp.c_str(), path.c_str()) != 0)
+            throw std::runtime_error("无法写入检查点: " + path);
+    }
+
+    // 运行到搜完、所有目标都已命中（find_all 为 false 时）或被取消；返回全部命中（含从检查点恢复的）
+    // 正常结束后删除检查点文件，被取消时保存
+    std::vector<SearchHit> run()
+    {
+        if (!cfg.checkpoint.empty())
+            load_checkpoint(cfg.checkpoint);
+        if (unresolved == 0 && !cfg.find_all)
+            return hits;
+        start = std::chrono::steady_clock::now();
+
+        workers = std::vector<Worker>(cfg.threads);
+        for (size_t i = 0; i < cfg.threads; ++i)
+        {
+            workers[i].begin = total * i / cfg.threads;
+            workers[i].end = total * (i + 1) / cfg.threads;
+        }
+        std::vector<std::thread> pool;
+        std::mutex running_mutex;
+        std::condition_variable running_cv;
+        size_t running = cfg.threads;
+        for (size_t i = 0; i < cfg.threads; ++i)
+            pool.emplace_back([this, i, &running, &running_mutex, &running_cv]
+                              {
+                work(i);
+                std::lock_guard<std::mutex> lock(running_mutex);
+                if (--running == 0)
+                    running_cv.notify_all(); });
+
+        // 主线程负责定时输出进度与保存检查点，工作线程全部结束时立即醒来
+        auto last_progress = start, last_checkpoint = start;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(running_mutex);
+                if (running_cv.wait_for(lock, std::chrono::milliseconds(50), [&]
+                                        { return running == 0; }))
+                    break;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (cfg.progress_interval > 0 && seconds(last_progress, now) >= cfg.progress_interval)
+            {
+                print_progress(now);
+                last_progress = now;
+            }
+            if (!cfg.checkpoint.empty() && seconds(last_checkpoint, now) >= cfg.checkpoint_interval)
+            {
+                save_checkpoint(cfg.checkpoint);
+                last_checkpoint = now;
+            }
+        }
+        for (auto &t : pool)
+            t.join();
+        elapsed = seconds(start, std::chrono::steady_clock::now());
+        if (progress_shown)
+            std::cerr << "\n";
+
+        if (!cfg.checkpoint.empty())
+        {
+            if (cancelled())
+                save_checkpoint(cfg.checkpoint);
+            else
+                std::remove(cfg.checkpoint.c_str());
+        }
+        // 检查点保存于某块的命中之后、该块完成之前时，恢复后这一块会重搜，同一命中出现两次
+        std::sort(hits.begin(), hits.end(), [](const SearchHit &a, const SearchHit &b)
+                  { return a.nonce != b.nonce ? a.nonce < b.nonce : a.message < b.message; });
+        hits.erase(std::unique(hits.begin(), hits.end(), [](const SearchHit &a, const SearchHit &b)
+                               { return a.nonce == b.nonce && a.message == b.message; }),
+                   hits.end());
+        return hits;
+    }
+
+    // 线程安全、可在信号处理函数中调用：工作线程在当前块结束后退出
+    void cancel() { stop_flag.store(true); }
+    // 被外部取消（而不是因为目标全部命中而停止）
+    bool cancelled() const { return stop_flag.load() && !(all_found.load() && !cfg.find_all); }
+
+    // 去重后的目标数与其中已找到命中的个数
+    size_t targets() const { return target_set.size(); }
+    size_t targets_found() const
+    {
+        std::lock_guard<std::mutex> lock(hits_mutex);
+        return target_set.size() - unresolved;
+    }
+
+    uint64_t tested() const { return tested_count.load(); }
+    double seconds_elapsed() const { return elapsed; }
+    size_t threads() const { return cfg.threads; }
+    uint64_t chunks() const { return total; }
+    uint64_t chunk_size() const { return chunk; }
+    const std::string &message(size_t i) const { return cfg.messages[i]; }
+    int nonce_bytes() const { return cfg.nonce_bytes; }
+    Sha256Impl impl() const { return Sha256Midstate((const unsigned char *)"", 0, cfg.nonce_bytes, cfg.impl).impl(); }
+    int lanes() const { return Sha256Midstate((const unsigned char *)"", 0, cfg.nonce_bytes, cfg.impl).lanes(); }
+
+private:
+    // 每个工作线程剩余的块号区间 [begin, end)：自己从头部取，其他线程从尾部偷
+    struct Worker
+    {
+        std::mutex mutex;
+        uint64_t begin = 0, end = 0;
+    };
+
+    static double seconds(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+    {
+        return std::chrono::duration<double>(b - a).count();
+    }
+
+    bool next_chunk(size_t self, uint64_t &c)
+    {
+        for (;;)
+        {
+            {
+                std::lock_guard<std::mutex> lock(workers[self].mutex);
+                if (workers[self].begin < workers[self].end)
+                {
+                    c = workers[self].begin++;
+                    return true;
+                }
+            }
+            // 从剩余最多的线程偷走后一半
+            size_t victim = self;
+            uint64_t most = 0;
+            for (size_t v = 0; v < workers.size(); ++v)
+            {
+                std::lock_guard<std::mutex> lock(workers[v].mutex);
+                if (v != self && workers[v].end - workers[v].begin > most)
+                {
+                    most = workers[v].end - workers[v].begin;
+                    victim = v;
+                }
+            }
+            if (most == 0)
+                return false;
+            uint64_t b, e;
+            {
+                std::lock_guard<std::mutex> lock(workers[victim].mutex);
+                uint64_t left = workers[victim].end - workers[victim].begin;
+                if (left == 0)
+                    continue; // 期间被取完了，重新挑
+                e = workers[victim].end;
+                b = e - (left + 1) / 2;
+                workers[victim].end = b;
+            }
+            std::lock_guard<std::mutex> lock(workers[self].mutex);
+            workers[self].begin = b;
+            workers[self].end = e;
+        }
+    }
+
+    void work(size_t self)
+    {
+        const size_t M = cfg.messages.size();
+        const int NB = cfg.nonce_bytes;
+        unsigned char nonces[16 * 8];
+        uint32_t digests[16][8];
+        uint64_t c;
+        while (!stop_flag.load(std::memory_order_relaxed) && next_chunk(self, c))
+        {
+            if (done[c / 64].load(std::memory_order_relaxed) >> (c % 64) & 1)
+                continue; // 检查点中已完成
+            size_t m = c % M;
+            uint64_t lo = cfg.nonce_min + (c / M) * chunk;
+            uint64_t n = std::min<uint64_t>(chunk - 1, cfg.nonce_max - lo) + 1; // 区间到 2^64-1 时 lo + chunk 会回绕
+            const std::string &msg = cfg.messages[m];
+            Sha256Midstate mid((const unsigned char *)msg.data(), msg.size(), NB, cfg.impl);
+            const int L = mid.lanes();
+            for (uint64_t off = 0; off < n; off += L)
+            {
+                uint64_t base = lo + off;
+                int valid = (int)std::min<uint64_t>(L, n - off); // 最后一组可能不满，多出的通道不参与比较
+                for (int l = 0; l < L; ++l)
+                {
+                    uint64_t v = base + l;
+                    for (int k = NB - 1; k >= 0; --k, v >>= 8)
+                        nonces[l * NB + k] = (unsigned char)v; // 大端
+                }
+                mid.hash_lanes(nonces, digests);
+                for (int l = 0; l < valid; ++l)
+                    if (target_set.find(digests[l]) != TargetSet::NONE)
+                        report_hit(m, base + l);
+            }
+            tested_count.fetch_add(n, std::memory_order_relaxed);
+            done[c / 64].fetch_or((uint64_t)1 << (c % 64), std::memory_order_relaxed);
+            completed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void report_hit(size_t m, uint64_t nonce)
+    {
+        std::lock_guard<std::mutex> lock(hits_mutex);
+        hits.push_back({m, nonce});
+        mark_resolved(hits.back());
+    }
+
+    // 重新计算命中的摘要以确定对应哪个目标（命中极少，不必在热循环里传递编号）；调用者持有 hits_mutex 或尚未启动线程
+    void mark_resolved(const SearchHit &h)
+    {
+        const std::string &msg = cfg.messages[h.message];
+        unsigned char nonce[8], digest[32];
+        uint64_t v = h.nonce;
+        for (int k = cfg.nonce_bytes - 1; k >= 0; --k, v >>= 8)
+            nonce[k] = (unsigned char)v;
+        Sha256Msg in = {(const unsigned char *)msg.data(), msg.size(), nonce, (size_t)cfg.nonce_bytes};
+        sha256_batch(&in, 1, &digest);
+        uint32_t w[8];
+        sha256_digest_words(digest, w);
+        uint32_t t = target_set.find(w);
+        if (t == TargetSet::NONE || resolved[t])
+            return;
+        resolved[t] = true;
+        if (--unresolved == 0)
+        {
+            all_found.store(true);
+            if (!cfg.find_all)
+                stop_flag.store(true);
+        }
+    }
+
+    void print_progress(std::chrono::steady_clock::time_point now)
+    {
+        uint64_t finished = resumed + completed.load(std::memory_order_relaxed);
+        double sec = seconds(start, now), rate = completed.load() / sec; // 本次运行的块/秒
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(1) << "\r进度 " << 100.0 * finished / total << "% (" << finished << "/"
+             << total << " 块), " << std::setprecision(2) << tested() / sec / 1e6 << " M/s, 剩余约 ";
+        if (rate > 0)
+            line << std::setprecision(0) << (total - finished) / rate << " s   ";
+        else
+            line << "? s   ";
+        std::cerr << line.str() << std::flush;
+        progress_shown = true;
+    }
+
+    // 搜索空间的指纹：字典、随机数区间与字节数、块大小、目标；检查点只能用于同一个空间
+    std::string space_fingerprint() const
+    {
+        std::ostringstream s;
+        s << cfg.nonce_min << " " << cfg.nonce_max << " " << cfg.nonce_bytes << " " << chunk << "\n";
+        for (auto &t : cfg.targets)
+            s.write((const char *)t.data(), 32);
+        for (auto &m : cfg.messages)
+            s << m.size() << ":" << m;
+        std::string data = s.str();
+        Sha256Msg msg = {(const unsigned char *)data.data(), data.size(), nullptr, 0};
+        unsigned char digest[32];
+        sha256_batch(&msg, 1, &digest);
+        static const char *HEX = "0123456789abcdef";
+        std::string hex;
+        for (unsigned char b : digest)
+            hex += std::string{HEX[b >> 4], HEX[b & 15]};
+        return hex;
+    }
+
+    SearchConfig cfg;
+    TargetSet target_set;
+    std::vector<bool> resolved; // 各目标是否已有命中，受 hits_mutex 保护
+    size_t unresolved = 0;
+    uint64_t chunk = 0, blocks = 0, total = 0, resumed = 0;
+    std::vector<std::atomic<uint64_t>> done; // 已完成块的位图
+    std::vector<Worker> workers;
+    std::atomic<bool> stop_flag{false}, all_found{false};
+    std::atomic<uint64_t> tested_count{0}, completed{0};
+    mutable std::mutex hits_mutex;
+    std::vector<SearchHit> hits;
+    std::string fingerprint;
+    std::chrono::steady_clock::time_point start;
+    double elapsed = 0;
+    bool progress_shown = false;
+};
+
+#endif // _search_hpp_
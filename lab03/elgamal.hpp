@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 #include <random>
+#include <memory>
 #include "utils.hpp"
 
 using namespace std;
@@ -72,12 +73,15 @@ private:
     BIGNUM *g;
     BIGNUM *x;
     BIGNUM *y;
+    std::unique_ptr<LagrangeCache> coeff_cache; // 分布式解密的拉格朗日系数缓存，随 p 重建
 public:
     ElGamal() { p = BN_new(); g = BN_new(); x = BN_new(); y = BN_new(); }
     void generate_secure_key_parameters();
     string get_public_key();
     string get_private_key();
     vector<std::pair<int, BIGNUM*>> split_secret_key(int threshold, int total_shares);
+    void save_key_shares(const string &path, const vector<std::pair<int, BIGNUM*>> &shares, int threshold);
+    vector<std::pair<int, BIGNUM*>> load_key_shares(const string &path);
     ElGamalCiphertext encrypt(int message);
     int decrypt(const ElGamalCiphertext &ciphertext);
     int distributed_decrypt(ElGamalCiphertext &dist_ciphertext, const vector<std::pair<int, BIGNUM*>> &shares);
@@ -113,6 +117,7 @@ void ElGamal::generate_secure_key_parameters() {
 
     // 将结果赋值给 p
     BN_copy(p, candidate_p);
+    coeff_cache.reset(); // 模数改变，旧系数失效
 
     // 2. 选取生成元 g
     BIGNUM *h = BN_new();
@@ -216,11 +221,26 @@ int ElGamal::decrypt(const ElGamalCiphertext &ciphertext)
     return result;
 }
 
+// 私钥份额写入二进制份额文件（模数 p 随文件保存）
+inline void ElGamal::save_key_shares(const string &path, const vector<std::pair<int, BIGNUM *>> &shares, int threshold)
+{
+    ShareWriter writer(path, p, threshold);
+    writer.write(shares);
+    writer.close();
+}
+
+// 读取私钥份额，文件的模数必须与当前密钥的 p 一致；只读重构所需的前 threshold 个
+inline vector<std::pair<int, BIGNUM *>> ElGamal::load_key_shares(const string &path)
+{
+    return read_share_file(path, p);
+}
+
 inline int ElGamal::distributed_decrypt(ElGamalCiphertext &dist_ciphertext, const vector<std::pair<int, BIGNUM *>> &shares)
 {
-    // 重构x
-    BIGNUM *re_x = BN_new();
-    re_x = reconstruct_secret(p, shares);
+    // 重构x：同一组份额持有者重复解密时直接复用缓存的拉格朗日系数
+    if (!coeff_cache)
+        coeff_cache.reset(new LagrangeCache(p));
+    BIGNUM *re_x = reconstruct_secret(p, shares, coeff_cache.get());
 
     BN_CTX *ctx = BN_CTX_new();
     BIGNUM *s = BN_new();
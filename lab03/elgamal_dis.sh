@@ -1 +1 @@
-g++ ./elgamal_distributed.cpp -o elgamal_distributed -lssl -lcrypto
\ No newline at end of file
+g++ ./elgamal_distributed.cpp -o elgamal_distributed -lssl -lcrypto -pthread
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <utility>
 #include <string>
 #include <algorithm>
+#include <cstdio>
 
 #include "elgamal.hpp"
 
@@ -64,6 +65,18 @@ int main()
     std::vector<std::pair<int, BIGNUM*>> shares = elgamal.split_secret_key(threshold, total_shares);
     std::cout << "生成了 " << total_shares << " 个份额，阈值为 " << threshold << std::endl;
 
+    // 份额以二进制份额文件交换：写出后读回前threshold个，解密结果应一致
+    const char *share_path = "elgamal_key_shares.bin";
+    elgamal.save_key_shares(share_path, shares, threshold);
+    std::vector<std::pair<int, BIGNUM*>> loaded_shares = elgamal.load_key_shares(share_path);
+    std::remove(share_path);
+    int loaded_decrypted = elgamal.distributed_decrypt(dist_ciphertext, loaded_shares);
+    std::cout << "从份额文件读回 " << loaded_shares.size() << " 个份额，解密验证: "
+              << (dist_message == loaded_decrypted ? "成功" : "失败") << std::endl;
+    for (auto &share : loaded_shares) {
+        BN_free(share.second);
+    }
+
     // 随机选择份额进行分布式解密 (只需要threshold个份额)
     std::vector<std::pair<int, BIGNUM*>> selected_shares;
     std::vector<int> available_indices;
@@ -8,6 +8,8 @@
 #include <openssl/rand.h>    // 随机数
 
 #include "utils.hpp"
+#include "ec256.hpp" // 定长 secp256k1 点运算与编码
+#include "hex.hpp"   // 查表十六进制编解码
 
 using namespace std;
 
@@ -33,27 +35,45 @@ FELDMAN_SHARES_AND_COMMITMENTS generate_feldman_shares_and_commitments(
     SHARES &shares = result.first;
     COMMITMENTS &commitments = result.second;
 
-    // 1. 生成份额
-    for (int i = 1; i <= n; i++)
-    {
-        BIGNUM *x = BN_new();
-        BN_set_word(x, i);                       // x = i
-        BIGNUM *y = eval_poly(coeffs, x, prime); // f(i) mod prime
-        shares.push_back({i, y});                // 添加份额 (i, f(i))
-        BN_free(x);
-    }
+    // 1. 生成份额 (i, f(i))，群阶 n 走定长域，系数只转换一次
+    shares = generate_shares(prime, coeffs, n);
 
-    // 2. 生成承诺
+    // 2. 生成承诺 Cj = aj * G：定长实现在雅可比坐标下计算，全部承诺共用一次求逆归一化后再转为 EC_POINT
+    BN_CTX *ctx = BN_CTX_new();
+    EcAffine<Secp256k1Curve> G = ec_from_openssl<Secp256k1Curve>(group, generator, ctx);
+    std::vector<EcPoint<Secp256k1Curve>> jac;
     for (size_t j = 0; j < coeffs.size(); j++)
+        jac.push_back(ec_mul2(EcScalar::from_bn(coeffs[j]), G, EcScalar(), G));
+    for (const auto &A : ec_batch_to_affine(jac))
     {
         EC_POINT *Cj = EC_POINT_new(group);
-        EC_POINT_mul(group, Cj, nullptr, generator, coeffs[j], nullptr); // Cj = aj * G
+        ec_to_openssl(group, A, Cj, ctx); // 仿射坐标直接设置，Z = 1
         commitments.push_back(Cj);
     }
+    BN_CTX_free(ctx);
 
     return result;
 }
 
+// 承诺点的压缩编码（十六进制）：承诺已是仿射坐标，不再求逆
+std::string point_to_hex(const EC_GROUP *group, const EC_POINT *P, BN_CTX *ctx)
+{
+    unsigned char buf[33];
+    return hex_encode(buf, ec_encode(ec_from_openssl<Secp256k1Curve>(group, P, ctx), buf));
+}
+
+// 解析十六进制的压缩（或非压缩）编码并检查在曲线上，失败返回 nullptr
+EC_POINT *point_from_hex(const EC_GROUP *group, const std::string &hex, BN_CTX *ctx)
+{
+    std::vector<unsigned char> buf;
+    EcAffine<Secp256k1Curve> A;
+    if (!hex_decode(hex, buf) || !ec_decode(buf.data(), buf.size(), A))
+        return nullptr;
+    EC_POINT *P = EC_POINT_new(group);
+    ec_to_openssl(group, A, P, ctx);
+    return P;
+}
+
 /// @brief 
 /// @param x 份额编号
 /// @param y 私有秘密
@@ -117,12 +137,28 @@ bool verify_share(
 
 int main(int argc, char *argv[])
 {
+    // 取出 --out/--in 选项（二进制份额文件），其余参数原样左移
+    std::string out_path, in_path;
+    int kept = 1;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string opt(argv[i]);
+        if ((opt == "--out" || opt == "--in") && i + 1 < argc)
+        {
+            (opt == "--out" ? out_path : in_path) = argv[++i];
+            continue;
+        }
+        argv[kept++] = argv[i];
+    }
+    argc = kept;
+
     if (argc < 2)
     { // 检查参数数量
         std::cerr << "用法:\n"
-                  << "  feldman share <secret_hex|'rand'> <t> <n>\n"                                // 生成份额和承诺模式
+                  << "  feldman share <secret_hex|'rand'> <t> <n> [--out <file>]\n"                 // 生成份额和承诺模式，--out 时份额写入二进制文件
                   << "  feldman verify <x> <y_hex> <commitment1> <commitment2> ... <coeff_count>\n" // 验证份额模式
-                  << "  feldman reconstruct <share1> <share2> ...\n";                               // 重构秘密模式
+                  << "  feldman reconstruct <share1> <share2> ...\n"                                // 重构秘密模式
+                  << "  feldman reconstruct --in <file>\n";                                         // 从二进制份额文件重构
         return 1;
     }
 
@@ -169,19 +205,37 @@ int main(int argc, char *argv[])
 
         auto [shares, commitments] = generate_feldman_shares_and_commitments(group, generator, prime, coeffs, n);
 
-        std::cout << "份额:\n";
-        for (auto &s : shares)
-        {                                                               // 输出每个份额
-            std::cout << s.first << ":" << bn_to_hex(s.second) << "\n"; // 格式：序号:y值（十六进制）
+        if (out_path.empty())
+        {
+            std::cout << "份额:\n";
+            for (auto &s : shares)
+            {                                                               // 输出每个份额
+                std::cout << s.first << ":" << bn_to_hex(s.second) << "\n"; // 格式：序号:y值（十六进制）
+            }
         }
+        else
+        {
+            try
+            {
+                ShareWriter writer(out_path, prime, t);
+                writer.write(shares);
+                writer.close();
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "错误: " << e.what() << "\n";
+                return 1;
+            }
+            std::cout << "份额已写入: " << out_path << "\n";
+        }
+        for (auto &s : shares)
+            BN_free(s.second); // 释放份额的y值
 
         std::cout << "承诺:\n";
+        BN_CTX *ctx = BN_CTX_new();
         for (size_t i = 0; i < commitments.size(); i++)
-        {
-            char *commitment_str = EC_POINT_point2hex(group, commitments[i], POINT_CONVERSION_COMPRESSED, nullptr);
-            std::cout << "C" << i << ":" << std::string(commitment_str) << "\n";
-            OPENSSL_free(commitment_str);
-        }
+            std::cout << "C" << i << ":" << point_to_hex(group, commitments[i], ctx) << "\n";
+        BN_CTX_free(ctx);
 
         BN_free(secret); // 释放秘密值
         for (auto c : coeffs)
@@ -203,23 +257,24 @@ int main(int argc, char *argv[])
         // Parse commitments
         int coeff_count = std::stoi(argv[argc - 1]); // 最后一个参数是系数数量
         std::vector<EC_POINT *> commitments(coeff_count);
+        BN_CTX *ctx = BN_CTX_new();
         for (int i = 0; i < coeff_count; i++)
         {
-            EC_POINT *commitment = EC_POINT_new(group);
-            BN_CTX *ctx = BN_CTX_new();
-            if (!EC_POINT_hex2point(group, argv[4 + i], commitment, ctx))
+            EC_POINT *commitment = point_from_hex(group, argv[4 + i], ctx);
+            if (!commitment)
             {
                 std::cerr << "无法解析承诺 " << i << "\n";
-                EC_POINT_free(commitment);
+                for (int j = 0; j < i; j++)
+                    EC_POINT_free(commitments[j]);
                 BN_CTX_free(ctx);
                 BN_free(y);
                 EC_GROUP_free(group);
                 BN_free(prime);
                 return 1;
             }
-            BN_CTX_free(ctx);
             commitments[i] = commitment;
         }
+        BN_CTX_free(ctx);
 
         bool valid = verify_share(x, y, commitments, group, generator, prime);
         std::cout << "份额验证: " << (valid ? "通过" : "失败") << "\n";
@@ -230,12 +285,24 @@ int main(int argc, char *argv[])
     }
     else if (mode == "reconstruct")
     { // 重构秘密模式
-        if (argc < 3)
+        if (argc < 3 && in_path.empty())
         {
             std::cerr << "reconstruct模式参数错误\n";
             return 1;
         }
         std::vector<std::pair<int, BIGNUM *>> shares; // 存储解析的份额
+        if (!in_path.empty())
+        {
+            try
+            {
+                shares = read_share_file(in_path, prime);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "错误: " << e.what() << "\n";
+                return 1;
+            }
+        }
         for (int i = 2; i < argc; i++)
         {                           // 解析每个份额参数
             std::string s(argv[i]); // 获取份额参数，格式为 "x:yhex"
@@ -1 +1 @@
-g++ --std=c++17 -o feldman feldman.cpp -lssl -lcrypto -g
\ No newline at end of file
+g++ --std=c++17 -o feldman feldman.cpp -lssl -lcrypto -pthread -g
\ No newline at end of file
@@ -0,0 +1,474 @@
+#ifndef _lagrange_hpp_
+#define _lagrange_hpp_
+
+#include <openssl/bn.h>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <algorithm>
+
+#include "fp256.hpp"
+#include "thread_pool.hpp"
+
+// 并行计算 e_i 时每段至少包含的 i 个数，t 较小时整段在调用线程上完成
+#define LAGRANGE_PARALLEL_GRAIN 32
+
+// 拉格朗日插值重构引擎
+// l_i(0) = prod_{j!=i} x_j / (x_j - x_i) = X / (x_i * d_i)
+// 其中 X = prod x_j，d_i = prod_{j!=i}(x_j - x_i)
+// 所有 e_i = x_i * d_i 通过 Montgomery 批量求逆（前缀积 -> 一次模逆 -> 逆序回代）
+// 只需一次模逆即可得到全部 e_i^{-1}，临时大整数全部预分配并在多次调用间复用
+// 当所有 x 都是小整数（份额序号）时，差值先在64位机器字内连乘，攒满一个字才乘入大整数，
+// 大整数超出模数192位后才取模一次，t*(t-1) 次大数乘法降为约 t*(t-1)/18 次取模
+// 模数为 secp256k1 的 p 或 n 时直接在定长 Fp256 域上计算，结果写回预分配的 BIGNUM
+// 通过 set_parallel_threads 开启多线程后，t*(t-1) 次乘法按 i 分段并行，每个线程使用自己的 BN_CTX 与临时变量
+class LagrangeEngine
+{
+public:
+    explicit LagrangeEngine(const BIGNUM *mod);
+    ~LagrangeEngine();
+    LagrangeEngine(const LagrangeEngine &) = delete;
+    LagrangeEngine &operator=(const LagrangeEngine &) = delete;
+
+    // 计算所有基函数在0处的值，out[i] = l_i(0)，out中的BIGNUM由引擎持有，下次调用前有效
+    const std::vector<BIGNUM *> &basis_at_zero(const std::vector<const BIGNUM *> &xs);
+
+    // 重构 f(0) = sum(y_i * l_i(0)) mod p，返回值由调用者释放
+    BIGNUM *reconstruct(const std::vector<std::pair<BIGNUM *, BIGNUM *>> &points);
+
+private:
+    // 每个线程独占的临时变量：BN_CTX 不能跨线程共享，Montgomery上下文只读可以共享
+    struct Scratch
+    {
+        BN_CTX *ctx;
+        BIGNUM *diff; // x_j - x_i
+        BIGNUM *tmp;
+        Scratch() : ctx(BN_CTX_new()), diff(BN_new()), tmp(BN_new()) {}
+        ~Scratch()
+        {
+            BN_free(diff);
+            BN_free(tmp);
+            BN_CTX_free(ctx);
+        }
+    };
+
+    void reserve(size_t t);
+    Scratch &scratch(size_t chunk);
+    // 连乘累积：第一个因子直接拷贝，其余用Montgomery乘法
+    void chain_mul(BIGNUM *acc, const BIGNUM *factor, bool first, Scratch &s);
+    // 小整数快速路径：factor 乘入机器字 word，溢出前把 word 乘入 acc
+    void word_mul(BIGNUM *acc, BN_ULONG &word, BN_ULONG factor, Scratch &s);
+    void word_flush(BIGNUM *acc, BN_ULONG &word, bool negative, Scratch &s);
+    void products_generic(const std::vector<const BIGNUM *> &xs);
+    void products_small(const std::vector<const BIGNUM *> &xs);
+    template <class F>
+    void basis_fixed(const std::vector<const BIGNUM *> &xs, bool small);
+
+    const BIGNUM *mod;
+    BN_CTX *ctx;
+    BN_MONT_CTX *mont;
+    std::vector<BIGNUM *> e;      // e_i = x_i * d_i
+    std::vector<BIGNUM *> prefix; // 前缀积 e_0 * ... * e_k
+    std::vector<BIGNUM *> basis;  // 输出的 l_i(0)
+    std::vector<std::unique_ptr<Scratch>> scratches; // 按段号索引，段0与单线程共用
+    BIGNUM *X;                                        // prod x_j
+    BIGNUM *inv;                                      // 批量求逆的当前逆元
+    BIGNUM *tmp;
+};
+
+inline LagrangeEngine::LagrangeEngine(const BIGNUM *mod) : mod(mod)
+{
+    ctx = BN_CTX_new();
+    mont = BN_MONT_CTX_new();
+    if (!ctx || !mont || !BN_MONT_CTX_set(mont, mod, ctx)) // 模数必须为奇数（素数）
+    {
+        BN_MONT_CTX_free(mont);
+        BN_CTX_free(ctx);
+        throw std::runtime_error("初始化Montgomery上下文失败");
+    }
+    X = BN_new();
+    inv = BN_new();
+    tmp = BN_new();
+}
+
+inline LagrangeEngine::~LagrangeEngine()
+{
+    for (auto v : {&e, &prefix, &basis})
+        for (auto b : *v)
+            BN_free(b);
+    BN_free(X);
+    BN_free(inv);
+    BN_free(tmp);
+    BN_MONT_CTX_free(mont);
+    BN_CTX_free(ctx);
+}
+
+inline void LagrangeEngine::reserve(size_t t)
+{
+    for (auto v : {&e, &prefix, &basis})
+        while (v->size() < t)
+            v->push_back(BN_new());
+}
+
+inline LagrangeEngine::Scratch &LagrangeEngine::scratch(size_t chunk)
+{
+    // 只在进入并行区之前扩容，各线程按段号取用互不冲突
+    while (scratches.size() <= chunk)
+        scratches.emplace_back(new Scratch());
+    return *scratches[chunk];
+}
+
+inline void LagrangeEngine::chain_mul(BIGNUM *acc, const BIGNUM *factor, bool first, Scratch &s)
+{
+    // n 个因子经 n-1 次Montgomery乘法后带有公共因子 R^{-(n-1)}
+    // X 与每个 e_i 都恰好是 t 个因子的乘积，比值 X / e_i 中该因子相互抵消，无需转换进出Montgomery域
+    if (first)
+        BN_copy(acc, factor);
+    else
+        BN_mod_mul_montgomery(acc, acc, factor, mont, s.ctx);
+}
+
+inline void LagrangeEngine::word_mul(BIGNUM *acc, BN_ULONG &word, BN_ULONG factor, Scratch &s)
+{
+    if (word > std::numeric_limits<BN_ULONG>::max() / factor)
+    {
+        BN_mul_word(acc, word);
+        if (BN_num_bits(acc) > BN_num_bits(mod) + 192)
+        {
+            BN_nnmod(s.tmp, acc, mod, s.ctx);
+            BN_copy(acc, s.tmp);
+        }
+        word = factor;
+    }
+    else
+        word *= factor;
+}
+
+inline void LagrangeEngine::word_flush(BIGNUM *acc, BN_ULONG &word, bool negative, Scratch &s)
+{
+    BN_mul_word(acc, word);
+    BN_nnmod(s.tmp, acc, mod, s.ctx);
+    if (negative && !BN_is_zero(s.tmp))
+        BN_sub(acc, mod, s.tmp);
+    else
+        BN_copy(acc, s.tmp);
+}
+
+inline void LagrangeEngine::products_small(const std::vector<const BIGNUM *> &xs)
+{
+    size_t t = xs.size();
+    std::vector<BN_ULONG> w(t);
+    for (size_t i = 0; i < t; ++i)
+        w[i] = BN_get_word(xs[i]);
+
+    // e_i = x_i * prod_{j!=i}(x_j - x_i)，差值为负时只记录符号；各 e_i 互相独立，按 i 分段并行
+    scratch(parallel_threads() - 1);
+    parallel_for(t, LAGRANGE_PARALLEL_GRAIN, [&](size_t chunk, size_t begin, size_t end)
+                 {
+        Scratch &s = *scratches[chunk];
+        for (size_t i = begin; i < end; ++i)
+        {
+            BN_ULONG word = w[i];
+            bool negative = false;
+            BN_one(e[i]);
+            for (size_t j = 0; j < t; ++j)
+            {
+                if (j == i)
+                    continue;
+                BN_ULONG d = w[j] > w[i] ? w[j] - w[i] : w[i] - w[j];
+                if (d == 0)
+                    throw std::runtime_error("没有逆元"); // 重复的x
+                negative ^= w[j] < w[i];
+                word_mul(e[i], word, d, s);
+            }
+            word_flush(e[i], word, negative, s);
+        } });
+
+    // X = prod x_j
+    BN_ULONG word = 1;
+    BN_one(X);
+    for (size_t j = 0; j < t; ++j)
+        word_mul(X, word, w[j], scratch(0));
+    word_flush(X, word, false, scratch(0));
+}
+
+inline void LagrangeEngine::products_generic(const std::vector<const BIGNUM *> &xs)
+{
+    size_t t = xs.size();
+    // e_i = x_i * prod_{j!=i}(x_j - x_i)，共 t*(t-1) 次乘法，不求逆
+    scratch(parallel_threads() - 1);
+    parallel_for(t, LAGRANGE_PARALLEL_GRAIN, [&](size_t chunk, size_t begin, size_t end)
+                 {
+        Scratch &s = *scratches[chunk];
+        for (size_t i = begin; i < end; ++i)
+        {
+            chain_mul(e[i], xs[i], true, s);
+            for (size_t j = 0; j < t; ++j)
+            {
+                if (j == i)
+                    continue;
+                BN_mod_sub(s.diff, xs[j], xs[i], mod, s.ctx);
+                chain_mul(e[i], s.diff, false, s);
+            }
+        } });
+
+    // X = prod x_j
+    for (size_t j = 0; j < t; ++j)
+        chain_mul(X, xs[j], j == 0, scratch(0));
+}
+
+template <class F>
+inline void LagrangeEngine::basis_fixed(const std::vector<const BIGNUM *> &xs, bool small)
+{
+    size_t t = xs.size();
+    std::vector<F> out(t), prefix_f;
+    F Xf = F::one();
+    if (small)
+    {
+        std::vector<uint64_t> w;
+        for (auto x : xs)
+            w.push_back(BN_get_word(x));
+        parallel_for(t, LAGRANGE_PARALLEL_GRAIN, [&](size_t, size_t begin, size_t end)
+                     {
+            for (size_t i = begin; i < end; ++i)
+                out[i] = fp_lagrange_denominator_small<F>(w, i); });
+        uint64_t word = 1;
+        for (uint64_t x : w)
+        {
+            if (word > UINT64_MAX / x)
+            {
+                Xf = Xf.mul_word(word);
+                word = x;
+            }
+            else
+                word *= x;
+        }
+        Xf = Xf.mul_word(word);
+    }
+    else
+    {
+        std::vector<F> xf;
+        for (auto x : xs)
+            xf.push_back(F::from_bn(x));
+        parallel_for(t, LAGRANGE_PARALLEL_GRAIN, [&](size_t, size_t begin, size_t end)
+                     {
+            for (size_t i = begin; i < end; ++i)
+                out[i] = fp_lagrange_denominator(xf, i); });
+        for (auto &x : xf)
+            Xf *= x;
+    }
+    fp_lagrange_finish(out, Xf, prefix_f); // 批量求逆只有一次域求逆，串行即可
+    for (size_t i = 0; i < t; ++i)
+        out[i].to_bn(basis[i]);
+}
+
+inline const std::vector<BIGNUM *> &LagrangeEngine::basis_at_zero(const std::vector<const BIGNUM *> &xs)
+{
+    size_t t = xs.size();
+    reserve(t);
+    if (t == 0)
+        return basis;
+
+    bool small = true;
+    for (auto x : xs)
+        small = small && !BN_is_zero(x) && !BN_is_negative(x) && BN_num_bits(x) <= 32;
+    if (with_fixed_field(mod, [&](auto field)
+                         { basis_fixed<decltype(field)>(xs, small); }))
+        return basis;
+
+    // 1. 计算 e_i 与 X
+    if (small)
+        products_small(xs);
+    else
+        products_generic(xs);
+
+    // 2. 前缀积
+    BN_copy(prefix[0], e[0]);
+    for (size_t i = 1; i < t; ++i)
+        BN_mod_mul(prefix[i], prefix[i - 1], e[i], mod, ctx);
+
+    // 3. 唯一一次模逆，存在重复或为0的x时无逆元
+    if (!BN_mod_inverse(inv, prefix[t - 1], mod, ctx))
+        throw std::runtime_error("没有逆元");
+
+    // 4. 逆序回代：e_i^{-1} = inv * prefix[i-1]，再令 inv *= e_i
+    for (size_t i = t; i-- > 0;)
+    {
+        if (i > 0)
+        {
+            BN_mod_mul(tmp, inv, prefix[i - 1], mod, ctx);
+            BN_mod_mul(inv, inv, e[i], mod, ctx);
+        }
+        else
+            BN_copy(tmp, inv);
+        BN_mod_mul(basis[i], X, tmp, mod, ctx); // l_i(0) = X * e_i^{-1}
+    }
+    return basis;
+}
+
+inline BIGNUM *LagrangeEngine::reconstruct(const std::vector<std::pair<BIGNUM *, BIGNUM *>> &points)
+{
+    std::vector<const BIGNUM *> xs;
+    xs.reserve(points.size());
+    for (auto &p : points)
+        xs.push_back(p.first);
+    const std::vector<BIGNUM *> &l = basis_at_zero(xs);
+
+    BIGNUM *result = BN_new();
+    BN_zero(result);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        BN_mod_mul(tmp, points[i].second, l[i], mod, ctx); // y_i * l_i(0)
+        BN_mod_add(result, result, tmp, mod, ctx);
+    }
+    return result;
+}
+
+// 固定份额持有者集合的拉格朗日系数缓存
+// 以排序后的x坐标集合为键，LRU淘汰；命中时重构只需 t 次乘加（宽累加器上乘加，最后取模一次）
+class LagrangeCache
+{
+public:
+    explicit LagrangeCache(const BIGNUM *mod, size_t capacity = 128);
+    ~LagrangeCache();
+    LagrangeCache(const LagrangeCache &) = delete;
+    LagrangeCache &operator=(const LagrangeCache &) = delete;
+
+    // 返回 sorted_xs（升序、互不相同）对应的 l_i(0)，指针在条目被淘汰前有效
+    const std::vector<BIGNUM *> &coefficients(const std::vector<int> &sorted_xs);
+
+    // 重构 f(0)，份额顺序任意，返回值由调用者释放
+    BIGNUM *reconstruct(const std::vector<std::pair<int, BIGNUM *>> &shares);
+
+    const BIGNUM *modulus() const { return mod; }
+    size_t hits = 0, misses = 0; // 统计信息
+
+private:
+    typedef std::pair<std::vector<int>, std::vector<BIGNUM *>> Entry;
+
+    BIGNUM *mod; // 模数副本，不依赖调用者的生命周期
+    size_t capacity;
+    LagrangeEngine engine;
+    std::list<Entry> lru; // 表头为最近使用
+    std::map<std::vector<int>, std::list<Entry>::iterator> index;
+    BN_CTX *ctx;
+    BIGNUM *acc;
+    BIGNUM *prod;
+};
+
+inline LagrangeCache::LagrangeCache(const BIGNUM *mod, size_t capacity)
+    : mod(BN_dup(mod)), capacity(std::max<size_t>(capacity, 1)), engine(this->mod)
+{
+    ctx = BN_CTX_new();
+    acc = BN_new();
+    prod = BN_new();
+}
+
+inline LagrangeCache::~LagrangeCache()
+{
+    for (auto &entry : lru)
+        for (auto b : entry.second)
+            BN_free(b);
+    BN_free(acc);
+    BN_free(prod);
+    BN_CTX_free(ctx);
+    BN_free(mod);
+}
+
+inline const std::vector<BIGNUM *> &LagrangeCache::coefficients(const std::vector<int> &sorted_xs)
+{
+    auto it = index.find(sorted_xs);
+    if (it != index.end())
+    {
+        ++hits;
+        lru.splice(lru.begin(), lru, it->second); // 移到表头
+        return it->second->second;
+    }
+    ++misses;
+
+    // 未命中：用批量求逆引擎计算一次
+    std::vector<BIGNUM *> xs_bn;
+    for (int x : sorted_xs)
+    {
+        BIGNUM *b = BN_new();
+        BN_set_word(b, x);
+        xs_bn.push_back(b);
+    }
+    std::vector<BIGNUM *> coeffs;
+    try
+    {
+        const std::vector<BIGNUM *> &l = engine.basis_at_zero(std::vector<const BIGNUM *>(xs_bn.begin(), xs_bn.end()));
+        for (size_t i = 0; i < sorted_xs.size(); ++i)
+            coeffs.push_back(BN_dup(l[i]));
+    }
+    catch (...)
+    {
+        for (auto b : xs_bn)
+            BN_free(b);
+        throw;
+    }
+    for (auto b : xs_bn)
+        BN_free(b);
+
+    if (lru.size() >= capacity) // 淘汰最久未使用的条目
+    {
+        for (auto b : lru.back().second)
+            BN_free(b);
+        index.erase(lru.back().first);
+        lru.pop_back();
+    }
+    lru.emplace_front(sorted_xs, std::move(coeffs));
+    index[sorted_xs] = lru.begin();
+    return lru.front().second;
+}
+
+inline BIGNUM *LagrangeCache::reconstruct(const std::vector<std::pair<int, BIGNUM *>> &shares)
+{
+    // 按x排序，得到缓存键以及每个份额在键中的位置
+    std::vector<size_t> order(shares.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+              { return shares[a].first < shares[b].first; });
+    std::vector<int> key;
+    key.reserve(shares.size());
+    for (size_t i : order)
+    {
+        if (shares[i].first <= 0)
+            throw std::runtime_error("份额序号必须为正整数");
+        key.push_back(shares[i].first);
+    }
+
+    const std::vector<BIGNUM *> &l = coefficients(key);
+
+    // sum(y_i * l_i) 先在不取模的宽累加器上累加，最后只取模一次
+    BN_zero(acc);
+    for (size_t k = 0; k < order.size(); ++k)
+    {
+        BN_mul(prod, shares[order[k]].second, l[k], ctx);
+        BN_add(acc, acc, prod);
+    }
+    BIGNUM *result = BN_new();
+    BN_nnmod(result, acc, mod, ctx);
+    return result;
+}
+
+// 进程内按模数共享的系数缓存，供 reconstruct_secret 默认使用
+inline LagrangeCache &lagrange_cache_for(const BIGNUM *mod)
+{
+    static std::map<std::string, std::unique_ptr<LagrangeCache>> caches;
+    char *hex = BN_bn2hex(mod);
+    std::string key(hex);
+    OPENSSL_free(hex);
+    auto it = caches.find(key);
+    if (it == caches.end())
+        it = caches.emplace(key, std::unique_ptr<LagrangeCache>(new LagrangeCache(mod))).first;
+    return *it->second;
+}
+
+#endif // _lagrange_hpp_
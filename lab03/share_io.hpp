@@ -0,0 +1,281 @@
+#ifndef _share_io_hpp_
+#define _share_io_hpp_
+
+#include <openssl/bn.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+// 二进制份额容器：代替 "x:HEX" 文本，大量份额时省去十六进制编解码并避开命令行长度限制
+// 文件布局（整数均为小端）：
+//   头部  "SHRB" | 版本(1字节) | 域编号(1字节) | 保留(2字节) | 门限 t(4字节) | 份额数(8字节)
+//         域编号为 SHARE_FIELD_CUSTOM 时紧跟模数：长度(2字节) + 大端字节
+//   记录  x(4字节) | y长度(2字节) | y大端字节
+// 写入端流式追加记录，关闭时回填份额数；读取端逐条读出，y 写入调用者提供的 BIGNUM，不做额外分配
+
+const char SHARE_FILE_MAGIC[4] = {'S', 'H', 'R', 'B'};
+const uint8_t SHARE_FILE_VERSION = 1;
+const size_t SHARE_FILE_HEADER = 20;
+const size_t SHARE_FILE_BUFFER = 1 << 20; // 文件流缓冲区1MiB
+
+// 内置域编号，其余模数（如ElGamal的1024位p）随文件保存
+enum ShareField : uint8_t
+{
+    SHARE_FIELD_CUSTOM = 0,
+    SHARE_FIELD_SECP256K1_P = 1, // shamir
+    SHARE_FIELD_SECP256K1_N = 2, // feldman
+};
+
+inline const char *share_field_hex(uint8_t id)
+{
+    switch (id)
+    {
+    case SHARE_FIELD_SECP256K1_P:
+        return "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F";
+    case SHARE_FIELD_SECP256K1_N:
+        return "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141";
+    default:
+        return nullptr;
+    }
+}
+
+inline uint8_t share_field_id(const BIGNUM *mod)
+{
+    for (uint8_t id : {SHARE_FIELD_SECP256K1_P, SHARE_FIELD_SECP256K1_N})
+    {
+        BIGNUM *known = nullptr;
+        BN_hex2bn(&known, share_field_hex(id));
+        bool same = BN_cmp(known, mod) == 0;
+        BN_free(known);
+        if (same)
+            return id;
+    }
+    return SHARE_FIELD_CUSTOM;
+}
+
+namespace share_io_detail
+{
+    inline void put_le(unsigned char *p, uint64_t v, int bytes)
+    {
+        for (int i = 0; i < bytes; ++i)
+            p[i] = (unsigned char)(v >> (8 * i));
+    }
+
+    inline uint64_t get_le(const unsigned char *p, int bytes)
+    {
+        uint64_t v = 0;
+        for (int i = bytes; i-- > 0;)
+            v = (v << 8) | p[i];
+        return v;
+    }
+}
+
+class ShareWriter
+{
+public:
+    ShareWriter(const std::string &path, const BIGNUM *mod, uint32_t threshold)
+        : path(path), buffer(SHARE_FILE_BUFFER)
+    {
+        out.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error("无法创建份额文件: " + path);
+        unsigned char header[SHARE_FILE_HEADER] = {0};
+        std::memcpy(header, SHARE_FILE_MAGIC, 4);
+        header[4] = SHARE_FILE_VERSION;
+        header[5] = share_field_id(mod);
+        share_io_detail::put_le(header + 8, threshold, 4);
+        out.write((const char *)header, sizeof(header));
+        if (header[5] == SHARE_FIELD_CUSTOM)
+            write_bn(mod);
+    }
+
+    ~ShareWriter()
+    {
+        if (out.is_open())
+        {
+            try
+            {
+                close();
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    ShareWriter(const ShareWriter &) = delete;
+    ShareWriter &operator=(const ShareWriter &) = delete;
+
+    void write(int x, const BIGNUM *y)
+    {
+        if (x <= 0)
+            throw std::runtime_error("份额序号必须为正整数");
+        unsigned char xb[4];
+        share_io_detail::put_le(xb, (uint32_t)x, 4);
+        out.write((const char *)xb, 4);
+        write_bn(y);
+        ++count;
+    }
+
+    void write(const std::vector<std::pair<int, BIGNUM *>> &shares)
+    {
+        for (auto &s : shares)
+            write(s.first, s.second);
+    }
+
+    // 回填份额数并关闭，写入失败时抛出异常
+    void close()
+    {
+        unsigned char cb[8];
+        share_io_detail::put_le(cb, count, 8);
+        out.seekp(12);
+        out.write((const char *)cb, 8);
+        out.close();
+        if (!out)
+            throw std::runtime_error("写入份额文件失败: " + path);
+    }
+
+private:
+    void write_bn(const BIGNUM *v)
+    {
+        int len = BN_num_bytes(v);
+        if (len > 0xFFFF)
+            throw std::runtime_error("份额过长");
+        bytes.resize(2 + len);
+        share_io_detail::put_le(bytes.data(), (uint64_t)len, 2);
+        BN_bn2bin(v, bytes.data() + 2);
+        out.write((const char *)bytes.data(), bytes.size());
+    }
+
+    std::string path;
+    std::vector<char> buffer;
+    std::vector<unsigned char> bytes;
+    std::ofstream out;
+    uint64_t count = 0;
+};
+
+class ShareReader
+{
+public:
+    explicit ShareReader(const std::string &path) : path(path), buffer(SHARE_FILE_BUFFER)
+    {
+        in.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        in.open(path, std::ios::binary);
+        if (!in)
+            throw std::runtime_error("无法打开份额文件: " + path);
+        unsigned char header[SHARE_FILE_HEADER];
+        if (!in.read((char *)header, sizeof(header)) || std::memcmp(header, SHARE_FILE_MAGIC, 4) != 0 ||
+            header[4] != SHARE_FILE_VERSION)
+            throw std::runtime_error("份额文件格式错误: " + path);
+        field = header[5];
+        threshold = (uint32_t)share_io_detail::get_le(header + 8, 4);
+        count = share_io_detail::get_le(header + 12, 8);
+        mod = BN_new();
+        if (field == SHARE_FIELD_CUSTOM)
+        {
+            if (!read_bn(mod))
+                throw std::runtime_error("份额文件格式错误: " + path);
+        }
+        else if (const char *hex = share_field_hex(field))
+            BN_hex2bn(&mod, hex);
+        else
+        {
+            BN_free(mod);
+            throw std::runtime_error("未知的份额域编号: " + std::to_string(field));
+        }
+    }
+
+    ~ShareReader() { BN_free(mod); }
+    ShareReader(const ShareReader &) = delete;
+    ShareReader &operator=(const ShareReader &) = delete;
+
+    const BIGNUM *modulus() const { return mod; }
+
+    // 读下一条记录，y 必须已分配；读完全部 count 条后返回 false
+    bool next(int &x, BIGNUM *y)
+    {
+        if (done == count)
+            return false;
+        unsigned char xb[4];
+        if (!in.read((char *)xb, 4) || !read_bn(y))
+            throw std::runtime_error("份额文件被截断: " + path);
+        uint64_t xv = share_io_detail::get_le(xb, 4);
+        if (xv == 0 || xv > (uint64_t)std::numeric_limits<int>::max())
+            throw std::runtime_error("份额序号超出范围: " + path);
+        x = (int)xv;
+        ++done;
+        return true;
+    }
+
+    // 读出至多 limit 条记录，y 由调用者释放
+    std::vector<std::pair<int, BIGNUM *>> read(uint64_t limit = std::numeric_limits<uint64_t>::max())
+    {
+        std::vector<std::pair<int, BIGNUM *>> shares;
+        shares.reserve((size_t)std::min<uint64_t>({limit, count - done, 1 << 20})); // 头部计数不可信，预留量设上限
+        int x;
+        while (shares.size() < limit)
+        {
+            BIGNUM *y = BN_new();
+            bool ok;
+            try
+            {
+                ok = next(x, y);
+            }
+            catch (...)
+            {
+                BN_free(y);
+                for (auto &s : shares)
+                    BN_free(s.second);
+                throw;
+            }
+            if (!ok)
+            {
+                BN_free(y);
+                break;
+            }
+            shares.push_back({x, y});
+        }
+        return shares;
+    }
+
+    uint8_t field = SHARE_FIELD_CUSTOM;
+    uint32_t threshold = 0; // 0 表示未记录门限
+    uint64_t count = 0;
+
+private:
+    bool read_bn(BIGNUM *v)
+    {
+        unsigned char lb[2];
+        if (!in.read((char *)lb, 2))
+            return false;
+        bytes.resize(share_io_detail::get_le(lb, 2));
+        if (!in.read((char *)bytes.data(), bytes.size()))
+            return false;
+        return BN_bin2bn(bytes.data(), (int)bytes.size(), v) != nullptr;
+    }
+
+    std::string path;
+    std::vector<char> buffer;
+    std::vector<unsigned char> bytes;
+    std::ifstream in;
+    BIGNUM *mod = nullptr;
+    uint64_t done = 0;
+};
+
+// 读取份额文件并检查其模数与 mod 一致；文件头记录了门限时只读重构所需的前 t 条，否则读取全部
+inline std::vector<std::pair<int, BIGNUM *>> read_share_file(const std::string &path, const BIGNUM *mod)
+{
+    ShareReader reader(path);
+    if (BN_cmp(reader.modulus(), mod) != 0)
+        throw std::runtime_error("份额文件的域与当前模数不一致: " + path);
+    return reader.read(reader.threshold ? reader.threshold : std::numeric_limits<uint64_t>::max());
+}
+
+#endif // _share_io_hpp_
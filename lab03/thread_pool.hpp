@@ -0,0 +1,148 @@
+#ifndef _thread_pool_hpp_
+#define _thread_pool_hpp_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+#include <queue>
+#include <vector>
+#include <algorithm>
+
+// 固定大小的线程池：工作线程常驻，parallel_for 把 [0, count) 切成连续的段分给各线程
+// 每段的下标区间固定，调用者按下标写结果即可得到与单线程完全一致的输出顺序
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threads)
+    {
+        for (size_t i = 0; i < threads; ++i)
+            workers.emplace_back([this]
+                                 { worker_loop(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto &w : workers)
+            w.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    // 执行 fn(chunk, begin, end)，chunk 为段号（0..chunks-1，可用来索引每线程的临时变量）
+    // 每段至少 grain 个元素；阻塞直到全部完成，第一个异常在调用线程重新抛出
+    void parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t, size_t)> &fn)
+    {
+        size_t chunks = std::min(workers.size(), std::max<size_t>(1, count / std::max<size_t>(1, grain)));
+        if (chunks <= 1)
+        {
+            fn(0, 0, count);
+            return;
+        }
+
+        std::mutex done_mutex;
+        std::condition_variable done_cv;
+        size_t remaining = chunks;
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t c = 0; c < chunks; ++c)
+            {
+                size_t begin = count * c / chunks, end = count * (c + 1) / chunks;
+                tasks.push([&, c, begin, end]
+                           {
+                    try
+                    {
+                        fn(c, begin, end);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> l(done_mutex);
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                    std::lock_guard<std::mutex> l(done_mutex);
+                    if (--remaining == 0)
+                        done_cv.notify_one(); });
+            }
+        }
+        cv.notify_all();
+
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done_cv.wait(lock, [&]
+                     { return remaining == 0; });
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    void worker_loop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this]
+                        { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+};
+
+// 进程内共享的线程池设置，默认单线程（不创建工作线程）
+inline size_t &parallel_threads_setting()
+{
+    static size_t threads = 1;
+    return threads;
+}
+
+// n == 0 表示使用全部硬件线程
+inline void set_parallel_threads(size_t n)
+{
+    if (n == 0)
+        n = std::max(1u, std::thread::hardware_concurrency());
+    parallel_threads_setting() = n;
+}
+
+inline size_t parallel_threads() { return parallel_threads_setting(); }
+
+// 按当前设置并行执行；单线程时直接在调用线程上跑完整个区间
+inline void parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t, size_t)> &fn)
+{
+    size_t threads = parallel_threads();
+    if (threads <= 1 || count < 2 * std::max<size_t>(1, grain))
+    {
+        fn(0, 0, count);
+        return;
+    }
+    static std::unique_ptr<ThreadPool> pool;
+    static std::mutex pool_mutex;
+    std::lock_guard<std::mutex> lock(pool_mutex); // 同一时刻只有一个 parallel_for 使用共享池（不可嵌套调用）
+    if (!pool || pool->size() != threads)
+        pool.reset(new ThreadPool(threads));
+    pool->parallel_for(count, grain, fn);
+}
+
+#endif // _thread_pool_hpp_
@@ -7,6 +7,9 @@
 #include <vector>
 #include <stdexcept>
 
+#include "lagrange.hpp"
+#include "share_io.hpp"
+
 // 将BIGNUM（大整数）转换为十六进制字符串
 std::string bn_to_hex(const BIGNUM *n)
 {
@@ -63,6 +66,17 @@ BIGNUM *eval_poly(const std::vector<BIGNUM *> &coeffs, const BIGNUM *x, const BI
     // 你的代码 在这里
 
     // std::cout << "Call " << __FUNCTION__ << "\n";
+    // secp256k1 的 p / n 走定长Montgomery域，循环内没有堆分配
+    BIGNUM *fixed = nullptr;
+    if (with_fixed_field(mod, [&](auto field)
+                         {
+        using F = decltype(field);
+        F fx = F::from_bn(x), acc;
+        for (size_t i = coeffs.size(); i-- > 0;)
+            acc = acc * fx + F::from_bn(coeffs[i]);
+        fixed = acc.to_bn(); }))
+        return fixed;
+
     auto res = BN_new(); // init
     BN_zero(res);
 
@@ -120,6 +134,21 @@ std::vector<std::pair<int, BIGNUM *>> generate_shares(BIGNUM *prime, const std::
     // std::cout << "Call " << __FUNCTION__ << "\n";
     std::vector<std::pair<int, BIGNUM *>> shares;
 
+    // 定长域：系数只转换一次，之后每个份额都是栈上的霍纳求值
+    if (with_fixed_field(prime, [&](auto field)
+                         {
+        using F = decltype(field);
+        std::vector<F> c;
+        for (auto coeff : coeffs)
+            c.push_back(F::from_bn(coeff));
+        F x, one = F::one();
+        for (int i = 1; i <= n; ++i)
+        {
+            x += one; // x = i
+            shares.push_back({i, fp_eval_poly(c, x).to_bn()});
+        } }))
+        return shares;
+
     auto len = coeffs.size();
     try {
 
@@ -148,83 +177,20 @@ BIGNUM *lagrange_reconstruct_at_zero(const std::vector<std::pair<BIGNUM *, BIGNU
     // 2. 重构值 = sum(yi * li(0))
     // 3. 所有运算都要在模mod下进行
     // 你的代码在这里
-    auto len = points.size();
-
-    BIGNUM *result = BN_new();
-    BN_zero(result);
-    BN_CTX *ctx = BN_CTX_new();
-
-    auto ZERO = BN_new();
-    BN_zero(ZERO);
-
-    for (int i = 0; i < len; ++i) {
-        BIGNUM *li = BN_new();
-        BN_one(li); // 初始化为1
-
-        // x - x_j / x_i - x_j
-        // len 个点计算 len - 1 个分式
-        for (int j = 0; j < len; ++j) { // len
-            if (j == i) continue; // len - 1
-
-            // -x_j mod mod
-            BIGNUM *_xj = BN_new();
-            BN_mod_sub(_xj, ZERO, points[j].first, mod, ctx);
-
-            // xi - xj mod mod
-            BIGNUM *xi_m_xj = BN_new();
-            BN_mod_sub(xi_m_xj, points[i].first, points[j].first, mod, ctx);
-
-            //  1 / (xi - xj) mod mod
-            BIGNUM *_xi_m_xj = modinv(xi_m_xj, mod);
-
-            // -xj / xi-xj mod mod
-            BIGNUM *final = BN_new();
-            BN_mod_mul(final, _xj, _xi_m_xj, mod, ctx);
-
-            // li *= final mod mod
-            BN_mod_mul(li, li, final, mod, ctx);
-
-            BN_free(_xj);
-            BN_free(xi_m_xj);
-            BN_free(_xi_m_xj);
-            BN_free(final);
-        }
-
-        // yi * li mod mod
-        BIGNUM *contrib = BN_new();
-        BN_mod_mul(contrib, points[i].second, li, mod, ctx);
-
-        // result += contrib mod mod
-        BN_mod_add(result, result, contrib, mod, ctx);
-
-        BN_free(li);
-        BN_free(contrib);
-    }
-    
-    return result;
-    return nullptr; // 临时返回，学生需要替换
+    // 使用批量求逆的重构引擎：全部基函数只需一次模逆，临时变量预分配复用
+    LagrangeEngine engine(mod);
+    return engine.reconstruct(points);
 }
 
 // 重构秘密
 // 使用拉格朗日插值法从给定的份额重构原始秘密
-BIGNUM *reconstruct_secret(BIGNUM *prime, const std::vector<std::pair<int, BIGNUM *>> &shares)
+// 系数按份额持有者集合缓存（默认使用按模数共享的进程内缓存），同一集合重复重构时只需 t 次乘加
+BIGNUM *reconstruct_secret(BIGNUM *prime, const std::vector<std::pair<int, BIGNUM *>> &shares, LagrangeCache *cache = nullptr)
 {
-    // 将整数x坐标转换为BIGNUM格式，以便用于拉格朗日插值
-    std::vector<std::pair<BIGNUM *, BIGNUM *>> pts; // 存储点(x,y)的向量
-    for (auto &p : shares)
-    { // 遍历每个份额
-        BIGNUM *xi = BN_new();
-        BN_set_word(xi, p.first);              // 将整数x坐标转换为BIGNUM
-        pts.push_back({xi, BN_dup(p.second)}); // 将点(x,y)添加到向量中
-    }
-    BIGNUM *secret = lagrange_reconstruct_at_zero(pts, prime); // 使用拉格朗日插值重构秘密
-    // 释放临时点
-    for (auto &pt : pts)
-    {
-        BN_free(pt.first);
-        BN_free(pt.second);
-    }
-    return secret; // 返回重构的秘密
+    LagrangeCache &c = cache ? *cache : lagrange_cache_for(prime);
+    if (BN_cmp(c.modulus(), prime) != 0)
+        throw std::runtime_error("系数缓存的模数不匹配");
+    return c.reconstruct(shares);
 }
 
 #endif
\ No newline at end of file
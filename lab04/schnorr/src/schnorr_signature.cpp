@@ -1,66 +1,27 @@
 #include "schnorr_signature.h"
+#include "ec256.hpp"
 #include <iostream>
 #include <cstring>
 #include <string>
 #include <stdexcept>
 
+// 由 x 坐标恢复 y 为偶数的点（与 sign 中对 R 的规范化一致）：
+// 按压缩编码 02||x 交给 ec_decode，开方在定长域里完成，并检查 x < p 与点在曲线上
 EC_POINT* reconstructPoint(const EC_GROUP* group, const BIGNUM* x, BN_CTX* ctx) {
     if (!group || !x || !ctx) {
         throw std::invalid_argument("Invalid input parameters");
     }
 
-    BIGNUM *a = BN_new(), *b = BN_new(), *p = BN_new();
-    BIGNUM *rhs = BN_new(), *y = BN_new();
-    EC_POINT* point = nullptr;
-
-    try {
-        // Get param a, b, p
-        if (!EC_GROUP_get_curve(group, p, a, b, ctx)) {
-            throw std::runtime_error("Failed to get curve parameters");
-        }
-
-        // calc x³ + ax + b (mod p)
-        BIGNUM *x3 = BN_new(), *ax = BN_new();
-        BN_mod_sqr(x3, x, p, ctx);               // x²
-        BN_mod_mul(x3, x3, x, p, ctx);          // x³
-        BN_mod_mul(ax, a, x, p, ctx);           // ax
-        BN_mod_add(rhs, x3, ax, p, ctx);        // x³ + ax
-        BN_mod_add(rhs, rhs, b, p, ctx);        // x³ + ax + b
-
-        // y² = x³ + ax + b (mod p)
-        if (!BN_mod_sqrt(y, rhs, p, ctx)) {
-            throw std::runtime_error("Failed to compute square root (no solution)");
-        }
-
-        // recover (x, y)
-        point = EC_POINT_new(group);
-        if (!EC_POINT_set_affine_coordinates(group, point, x, y, ctx)) {
-            throw std::runtime_error("Failed to set point coordinates");
-        }
-
-        if (!EC_POINT_is_on_curve(group, point, ctx)) {
-            throw std::runtime_error("Reconstructed point is not on the curve");
-        }
-
-        // free
-        BN_free(a);
-        BN_free(b);
-        BN_free(p);
-        BN_free(rhs);
-        BN_free(x3);
-        BN_free(ax);
-        BN_free(y);
-
-        return point;
-    } catch (...) {
-        BN_free(a);
-        BN_free(b);
-        BN_free(p);
-        BN_free(rhs);
-        BN_free(y);
-        if (point) EC_POINT_free(point);
-        throw;
+    unsigned char buf[33];
+    buf[0] = 0x02;
+    EcAffine<Secp256k1Curve> A;
+    if (BN_is_negative(x) || BN_bn2binpad(x, buf + 1, 32) != 32 || !ec_decode(buf, sizeof(buf), A)) {
+        throw std::runtime_error("Failed to compute square root (no solution)");
     }
+
+    EC_POINT* point = EC_POINT_new(group);
+    ec_to_openssl(group, A, point, ctx);
+    return point;
 }
 
 SchnorrSignature::SchnorrSignature() : m_group(nullptr), m_order(nullptr), 
@@ -175,7 +136,14 @@ bool SchnorrSignature::sign(const std::string& message, const BIGNUM* private_ke
 
         // set r = R.x
         r = BN_new();
-        EC_POINT_get_affine_coordinates(m_group, R, r, nullptr, m_ctx);
+        auto Ry = BN_new();
+        EC_POINT_get_affine_coordinates(m_group, R, r, Ry, m_ctx);
+        // 签名只携带 R 的 x 坐标，验证方按偶数 y 恢复 R：y 为奇数时改用 -k，使 R = -R 的 y 为偶数
+        if (BN_is_odd(Ry)) {
+            BN_sub(k, m_order, k);
+            EC_POINT_invert(m_group, R, m_ctx);
+        }
+        BN_free(Ry);
 
         auto e = BN_new();
         auto P = EC_POINT_new(m_group);
@@ -225,39 +193,29 @@ bool SchnorrSignature::verify(const std::string& message, const BIGNUM* r, const
             return false;
         }
         // recover R from r
-        auto R = EC_POINT_new(m_group);
-        R = reconstructPoint(m_group, r, m_ctx);
+        EC_POINT* R = reconstructPoint(m_group, r, m_ctx);
 
         // calc e
-        auto e = BN_new();
-        e = hashChallenge(R, public_key, message);
-        // calc sG + eP
-        auto sG = EC_POINT_new(m_group);
-        EC_POINT_mul(m_group, sG, s, nullptr, nullptr, m_ctx);
-
-        auto eP = EC_POINT_new(m_group);
-        EC_POINT_mul(m_group, eP, nullptr, public_key, e, m_ctx);
-
-        auto R_dot = EC_POINT_new(m_group);
-        EC_POINT_add(m_group, R_dot, sG, eP, m_ctx);
-
-        auto x_R_dot = BN_new();
-        EC_POINT_get_affine_coordinates(m_group, R_dot, x_R_dot, nullptr, m_ctx);
-
-        if (BN_cmp(r, x_R_dot) == 0) {
-            // free
-            BN_free(x_R_dot);
-            EC_POINT_free(R);
-            EC_POINT_free(sG);
-            EC_POINT_free(eP);
-            EC_POINT_free(R_dot);
-            BN_free(e);
-
-            return true;
-        } else {
+        BIGNUM* e = hashChallenge(R, public_key, message);
+        EC_POINT_free(R);
+        if (!e) {
             return false;
         }
 
+        // calc R' = sG + eP：一次双标量乘法（Straus 交错 wNAF），不产生 sG、eP 中间点
+        EC_POINT* R_dot = EC_POINT_new(m_group);
+        BIGNUM* x_R_dot = BN_new();
+        bool ok = ec_mul2(m_group, R_dot, s, m_generator, e, public_key, m_ctx) &&
+                  !EC_POINT_is_at_infinity(m_group, R_dot) &&
+                  EC_POINT_get_affine_coordinates(m_group, R_dot, x_R_dot, nullptr, m_ctx) &&
+                  BN_cmp(r, x_R_dot) == 0;
+
+        // free
+        BN_free(x_R_dot);
+        EC_POINT_free(R_dot);
+        BN_free(e);
+        return ok;
+
     } catch (...) {
         (void)r;
         (void)s;
@@ -276,52 +234,20 @@ BIGNUM* SchnorrSignature::sha256AsBn(const unsigned char* data, size_t data_len)
 
 BIGNUM* SchnorrSignature::hashChallenge(const EC_POINT* R, const EC_POINT* P, 
                                        const std::string& message) {
-    // 将R和P序列化为字节
-    size_t r_buf_len = EC_POINT_point2oct(m_group, R, POINT_CONVERSION_COMPRESSED, nullptr, 0, m_ctx);
-    size_t p_buf_len = EC_POINT_point2oct(m_group, P, POINT_CONVERSION_COMPRESSED, nullptr, 0, m_ctx);
-    
-    if (r_buf_len == 0 || p_buf_len == 0) {
-        return nullptr;
-    }
-    
-    unsigned char* r_buf = new unsigned char[r_buf_len];
-    unsigned char* p_buf = new unsigned char[p_buf_len];
-    
-    if (!r_buf || !p_buf) {
-        delete[] r_buf;
-        delete[] p_buf;
-        return nullptr;
-    }
-    
-    if (EC_POINT_point2oct(m_group, R, POINT_CONVERSION_COMPRESSED, r_buf, r_buf_len, m_ctx) != r_buf_len ||
-        EC_POINT_point2oct(m_group, P, POINT_CONVERSION_COMPRESSED, p_buf, p_buf_len, m_ctx) != p_buf_len) {
-        delete[] r_buf;
-        delete[] p_buf;
-        return nullptr;
-    }
-    
-    // 连接 R || P || message
-    size_t total_len = r_buf_len + p_buf_len + message.length();
-    unsigned char* concat = new unsigned char[total_len];
-    
-    if (!concat) {
-        delete[] r_buf;
-        delete[] p_buf;
+    // 将R和P序列化为压缩编码并连接 R || P || message
+    std::vector<unsigned char> concat(66 + message.length());
+    try {
+        if (ec_encode(ec_from_openssl<Secp256k1Curve>(m_group, R, m_ctx), concat.data()) != 33 ||
+            ec_encode(ec_from_openssl<Secp256k1Curve>(m_group, P, m_ctx), concat.data() + 33) != 33) {
+            return nullptr; // 无穷远点
+        }
+    } catch (...) {
         return nullptr;
     }
-    
-    memcpy(concat, r_buf, r_buf_len);
-    memcpy(concat + r_buf_len, p_buf, p_buf_len);
-    memcpy(concat + r_buf_len + p_buf_len, message.c_str(), message.length());
-    
+    memcpy(concat.data() + 66, message.data(), message.length());
+
     // 哈希连接的数据
-    BIGNUM* challenge = sha256AsBn(concat, total_len);
-    
-    delete[] r_buf;
-    delete[] p_buf;
-    delete[] concat;
-    
-    return challenge;
+    return sha256AsBn(concat.data(), concat.size());
 }
 
 std::string SchnorrSignature::bnToHex(const BIGNUM* bn) {